@@ -1,10 +1,24 @@
 #include <vector>
 #include <cstring>
 #include <string>
+#include <algorithm>
+#include <stdexcept>
 #include <utility>
 #include <iterator>
+#include <functional>
 #include <type_traits>
+#include <bit>
+#include <string_view>
+#include <array>
+#include <atomic>
+#include <thread>
 #include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef DB_INSTRUMENT
+#include <mutex>
+#endif
 
 // DATA TYPES
 namespace db
@@ -34,6 +48,279 @@ namespace db
 	};
 }
 
+// INSTRUMENTATION
+// define DB_INSTRUMENT before including to record call counts, rdtsc cycle and input length
+// histograms per primitive, without it every DB_INSTRUMENT_* macro compiles to nothing
+#ifdef DB_INSTRUMENT
+namespace db::instrument
+{
+	enum class func : db::uint32_t
+	{
+		memcpy, memcmp, memchr, rmemchr,
+		strlen, fast_strlen, fast_strlen_simd, guess_base, find, split,
+		pow, powm, big_uint_mul, big_uint_divmod,
+		ftos, ntobs, ntods, ntohs, base64_encode, base64_decode,
+		crc32c, crc32, adler32,
+		varint_encode, varint_decode, streamvbyte_encode, streamvbyte_decode, bitpack_encode, bitpack_decode,
+		fstod, bston, dston, hston, ston,
+		radix_sort, binary_search, intersect, merge_union, difference, static_map_find, pgm_index_lower_bound,
+		count
+	};
+
+	constexpr const char* func_names[static_cast<db::size_t>(func::count)] = {
+		"memcpy", "memcmp", "memchr", "rmemchr",
+		"strlen", "fast_strlen", "fast_strlen_simd", "guess_base", "find", "split",
+		"pow", "powm", "big_uint_mul", "big_uint_divmod",
+		"ftos", "ntobs", "ntods", "ntohs", "base64_encode", "base64_decode",
+		"crc32c", "crc32", "adler32",
+		"varint_encode", "varint_decode", "streamvbyte_encode", "streamvbyte_decode", "bitpack_encode", "bitpack_decode",
+		"fstod", "bston", "dston", "hston", "ston",
+		"radix_sort", "binary_search", "intersect", "merge_union", "difference", "static_map_find", "pgm_index_lower_bound"
+	};
+
+	// * log2 buckets, bucket i holds values in [2^(i-1), 2^i)
+	constexpr db::size_t buckets = 65;
+
+	struct stats
+	{
+		db::uint64_t calls = 0;
+		db::uint64_t cycles[buckets]{};
+		db::uint64_t sizes[buckets]{};
+	};
+
+	struct snapshot_t
+	{
+		stats funcs[static_cast<db::size_t>(func::count)]{};
+	};
+
+	// * counters of one thread, only written by the owning thread
+	struct thread_table
+	{
+		struct counters
+		{
+			std::atomic<db::uint64_t> calls{ 0 };
+			std::atomic<db::uint64_t> cycles[buckets]{};
+			std::atomic<db::uint64_t> sizes[buckets]{};
+		};
+
+		counters funcs[static_cast<db::size_t>(func::count)];
+		thread_table* prev = nullptr;
+		thread_table* next = nullptr;
+
+		thread_table() noexcept;
+		~thread_table();
+
+		void add_to(db::instrument::snapshot_t& _snap) const noexcept
+		{
+			for (db::size_t f = 0; f != static_cast<db::size_t>(func::count); ++f) {
+				_snap.funcs[f].calls += funcs[f].calls.load(std::memory_order_relaxed);
+				for (db::size_t i = 0; i != buckets; ++i) {
+					_snap.funcs[f].cycles[i] += funcs[f].cycles[i].load(std::memory_order_relaxed);
+					_snap.funcs[f].sizes[i] += funcs[f].sizes[i].load(std::memory_order_relaxed);
+				}
+			}
+		}
+	};
+
+	// * live thread tables and the counts of threads that already exited
+	// the tables are an intrusive list behind a spin lock so registering never allocates or throws
+	struct registry
+	{
+		std::atomic_flag busy;
+		thread_table* tables = nullptr;
+		db::instrument::snapshot_t retired;
+
+		void lock() noexcept
+		{
+			while (busy.test_and_set(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+		}
+
+		void unlock() noexcept { busy.clear(std::memory_order_release); }
+	};
+
+	inline db::instrument::registry& get_registry() noexcept
+	{
+		static db::instrument::registry reg;
+		return reg;
+	}
+
+	inline thread_table::thread_table() noexcept
+	{
+		auto& reg = db::instrument::get_registry();
+		std::lock_guard<db::instrument::registry> guard(reg);
+		next = reg.tables;
+		if (next) {
+			next->prev = this;
+		}
+		reg.tables = this;
+	}
+
+	inline thread_table::~thread_table()
+	{
+		auto& reg = db::instrument::get_registry();
+		std::lock_guard<db::instrument::registry> guard(reg);
+		add_to(reg.retired);
+		(prev ? prev->next : reg.tables) = next;
+		if (next) {
+			next->prev = prev;
+		}
+	}
+
+	inline db::instrument::thread_table& local_table() noexcept
+	{
+		thread_local db::instrument::thread_table table;
+		return table;
+	}
+
+	// * single writer, so a relaxed load and store is enough and never locks
+	inline void bump(std::atomic<db::uint64_t>& _counter) noexcept
+	{
+		_counter.store(_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	inline void record(const db::instrument::func _func, const db::uint64_t _cycles, const db::uint64_t _size) noexcept
+	{
+		auto& counters = db::instrument::local_table().funcs[static_cast<db::size_t>(_func)];
+		db::instrument::bump(counters.calls);
+		db::instrument::bump(counters.cycles[std::bit_width(_cycles)]);
+		db::instrument::bump(counters.sizes[std::bit_width(_size)]);
+	}
+
+	// * times the enclosing scope, does nothing during constant evaluation
+	class scope
+	{
+	public:
+		constexpr scope(const db::instrument::func _func, const db::uint64_t _size) noexcept
+			: _which(_func), _input_size(_size), _start(0)
+		{
+			if (!std::is_constant_evaluated()) {
+				_start = __rdtsc();
+			}
+		}
+
+		constexpr ~scope()
+		{
+			if (!std::is_constant_evaluated()) {
+				db::instrument::record(_which, __rdtsc() - _start, _input_size);
+			}
+		}
+
+		// * for primitives that only know their input length at the end
+		constexpr void set_size(const db::uint64_t _size) noexcept { _input_size = _size; }
+
+	private:
+		db::instrument::func _which;
+		db::uint64_t _input_size;
+		db::uint64_t _start;
+	};
+
+	// * times the enclosing scope like scope, the input length is how far _pos moved until the scope ends
+	// for parsers that walk a null terminated string once, so they need no extra strlen
+	template <class char_type>
+	class cursor_scope
+	{
+	public:
+		constexpr cursor_scope(const db::instrument::func _func, const char_type* const& _pos) noexcept
+			: _which(_func), _begin(_pos), _cursor(_pos), _start(0)
+		{
+			if (!std::is_constant_evaluated()) {
+				_start = __rdtsc();
+			}
+		}
+
+		constexpr ~cursor_scope()
+		{
+			if (!std::is_constant_evaluated()) {
+				db::instrument::record(_which, __rdtsc() - _start, static_cast<db::uint64_t>(_cursor - _begin));
+			}
+		}
+
+	private:
+		db::instrument::func _which;
+		const char_type* _begin;
+		const char_type* const& _cursor;
+		db::uint64_t _start;
+	};
+
+	// * sum of every thread that recorded anything so far
+	inline db::instrument::snapshot_t snapshot()
+	{
+		db::instrument::snapshot_t snap;
+		auto& reg = db::instrument::get_registry();
+		std::lock_guard<db::instrument::registry> guard(reg);
+		for (db::size_t f = 0; f != static_cast<db::size_t>(func::count); ++f) {
+			snap.funcs[f] = reg.retired.funcs[f];
+		}
+		for (const thread_table* table = reg.tables; table; table = table->next) {
+			table->add_to(snap);
+		}
+		return snap;
+	}
+
+	// * snapshot as json, histograms only list filled buckets as "upper bound": count
+	inline std::string to_json(const db::instrument::snapshot_t& _snap)
+	{
+		const auto histogram = [](std::string& _out, const db::uint64_t* _buckets) {
+			_out += '{';
+			bool first = true;
+			for (db::size_t i = 0; i != buckets; ++i) {
+				if (_buckets[i] == 0) {
+					continue;
+				}
+				if (!first) {
+					_out += ',';
+				}
+				first = false;
+				_out += '"';
+				_out += (i == 64 ? std::string("18446744073709551615") : std::to_string((1ULL << i) - 1));
+				_out += "\":";
+				_out += std::to_string(_buckets[i]);
+			}
+			_out += '}';
+		};
+
+		std::string out = "{";
+		bool first = true;
+		for (db::size_t f = 0; f != static_cast<db::size_t>(func::count); ++f) {
+			const auto& stats = _snap.funcs[f];
+			if (stats.calls == 0) {
+				continue;
+			}
+			if (!first) {
+				out += ',';
+			}
+			first = false;
+			out += '"';
+			out += db::instrument::func_names[f];
+			out += "\":{\"calls\":";
+			out += std::to_string(stats.calls);
+			out += ",\"cycles\":";
+			histogram(out, stats.cycles);
+			out += ",\"sizes\":";
+			histogram(out, stats.sizes);
+			out += '}';
+		}
+		out += '}';
+		return out;
+	}
+
+	inline std::string dump_json()
+	{
+		return db::instrument::to_json(db::instrument::snapshot());
+	}
+}
+
+#define DB_INSTRUMENT_SCOPE(_func, _size) db::instrument::scope _db_instrument_scope(db::instrument::func::_func, static_cast<db::uint64_t>(_size))
+#define DB_INSTRUMENT_SIZE(_size) _db_instrument_scope.set_size(static_cast<db::uint64_t>(_size))
+#define DB_INSTRUMENT_CURSOR(_func, _pos) db::instrument::cursor_scope _db_instrument_scope(db::instrument::func::_func, _pos)
+#else
+#define DB_INSTRUMENT_SCOPE(_func, _size)
+#define DB_INSTRUMENT_SIZE(_size)
+#define DB_INSTRUMENT_CURSOR(_func, _pos)
+#endif
+
 // MEM OPERATIONS
 namespace db
 {
@@ -52,12 +339,13 @@ namespace db
 			return db::raw_memcpy<Ty>(_dst, _src, _size);
 		}
 		else {
+			DB_INSTRUMENT_SCOPE(memcpy, _size);
 			return static_cast<Ty*>(std::memcpy(_dst, _src, _size * sizeof(Ty)));
 		}
 	}
 
 	template <class Ty>
-	constexpr inline db::int32_t raw_memcmp(const Ty* const _buff1, const Ty* const _buff2, db::size_t _size) noexcept
+	constexpr inline db::int32_t raw_memcmp(const Ty* _buff1, const Ty* _buff2, db::size_t _size) noexcept
 	{
 		for (; 0 < _size; ++_buff1, ++_buff2, --_size) {
 			if (*_buff1 != *_buff2) {
@@ -74,7 +362,8 @@ namespace db
 			return db::raw_memcmp(_buff1, _buff2, _size);
 		}
 		else {
-			return std::memcmp(_buff1, _buff2, _size);
+			DB_INSTRUMENT_SCOPE(memcmp, _size);
+			return std::memcmp(_buff1, _buff2, _size * sizeof(Ty));
 		}
 	}
 
@@ -96,6 +385,7 @@ namespace db
 	template <class Ty>
 	constexpr inline const Ty* rmemchr(const Ty* _str, const Ty _ch, const db::size_t _len)
 	{
+		DB_INSTRUMENT_SCOPE(rmemchr, _len);
 		return db::raw_rmemchr(_str, _ch, _len);
 	}
 
@@ -118,6 +408,7 @@ namespace db
 			return db::raw_memchr<Ty>(_str, _ch, _maxlen);
 		}
 		else {
+			DB_INSTRUMENT_SCOPE(memchr, _maxlen);
 			return static_cast<const Ty*>(std::memchr(_str, _ch, _maxlen));
 		}
 	}
@@ -130,6 +421,7 @@ namespace db
 	template <class char_type>
 	inline db::size_t fast_strlen_simd(const char_type* _begin)
 	{
+		DB_INSTRUMENT_SCOPE(fast_strlen_simd, 0);
 		const char_type* end = _begin;
 
 		// skip 32 byte chunks
@@ -163,6 +455,7 @@ namespace db
 		// count rest one by one
 		for (; *end != char_type(); ++end);
 
+		DB_INSTRUMENT_SIZE(end - _begin);
 		return static_cast<db::size_t>(end - _begin);
 	}
 
@@ -170,6 +463,7 @@ namespace db
 	template <class char_type>
 	constexpr inline db::size_t fast_strlen(const char_type* _begin)
 	{
+		DB_INSTRUMENT_SCOPE(fast_strlen, 0);
 		constexpr db::size_t mask_high = static_cast<db::size_t>(0x8080808080808080U); // Works for X64 and X86
 		constexpr db::size_t mask_low  = static_cast<db::size_t>(0x0101010101010101U);
 		const db::size_t* aligned_end = reinterpret_cast<const db::size_t*>(_begin);
@@ -187,6 +481,7 @@ namespace db
 		// Count rest one by one
 		for (; *end != char_type(); ++end);
 
+		DB_INSTRUMENT_SIZE(end - _begin);
 		return static_cast<db::size_t>(end - _begin);
 	}
 
@@ -203,21 +498,29 @@ namespace db
 	template <class char_type>
 	constexpr inline db::size_t strlen(const char_type* _begin)
 	{
+		DB_INSTRUMENT_SCOPE(strlen, 0);
+
 		if constexpr (std::is_same_v<char, char_type>
 #ifdef	__cpp_char8_t
 			|| std::is_same_v<char8_t, char_type>) {
 #else
 			) {
 #endif 
-			return std::strlen(reinterpret_cast<const char*>(_begin));
+			const db::size_t len = std::strlen(reinterpret_cast<const char*>(_begin));
+			DB_INSTRUMENT_SIZE(len);
+			return len;
 		}
 
 		if constexpr (std::is_same_v<wchar_t, char_type> || std::is_same_v<char16_t, char_type>) {
-			return std::wcslen(reinterpret_cast<const wchar_t*>(_begin));
+			const db::size_t len = std::wcslen(reinterpret_cast<const wchar_t*>(_begin));
+			DB_INSTRUMENT_SIZE(len);
+			return len;
 		}
 
 		if constexpr (std::is_same_v<char32_t, char_type>) {
-			return db::raw_strlen<char32_t>(_begin);
+			const db::size_t len = db::raw_strlen<char32_t>(_begin);
+			DB_INSTRUMENT_SIZE(len);
+			return len;
 		}
 
 		throw std::invalid_argument("no type of char specified.");
@@ -227,6 +530,8 @@ namespace db
 	template <class char_type>
 	constexpr inline db::uint16_t guess_base(const char_type* _str) noexcept
 	{
+		DB_INSTRUMENT_CURSOR(guess_base, _str);
+
 		if (_str[1] == 'x' || _str[1] == 'X') {
 			return 16;
 		}
@@ -263,636 +568,3998 @@ namespace db
 			return 10;
 		}
 	}
-}
 
-// NUMBER OPERATIONS / MATH
-namespace db
-{
-	// * Signed to Unsigned number
-	template <class From, class To = std::make_unsigned_t<From>>
-	constexpr inline To to_unsigned(const From _num) noexcept
+	// * broadcast one char of any type into all lanes
+	template <class char_type>
+	inline __m256i set1_simd(const char_type _ch) noexcept
 	{
-		constexpr bool same_type = std::is_same_v<From, To>;
-		constexpr bool can_negative = !std::is_unsigned_v<From>;
-#if _HAS_CXX17
-		if constexpr (can_negative && !same_type) {
-#else
-		if (can_negative) {
-#endif
-			if (_num < 0) {
-				return (static_cast<From>(0) - static_cast<To>(_num));
-			}
+		static_assert(sizeof(char_type) == 1 || sizeof(char_type) == 2 || sizeof(char_type) == 4, "unsupported char type");
+
+		if constexpr (sizeof(char_type) == 1) {
+			return _mm256_set1_epi8(static_cast<char>(_ch));
 		}
-		return _num;
+		else if constexpr (sizeof(char_type) == 2) {
+			return _mm256_set1_epi16(static_cast<short>(_ch));
 		}
-
-	// * Unsigned to Signed number
-	template <class To = db::int64_t, class From>
-	constexpr inline To to_signed(const From _num) noexcept
-	{
-		constexpr bool is_unsigned = std::is_unsigned_v<From>;
-#if _HAS_CXX17
-		if constexpr(is_unsigned) {
-#else 
-		if (is_unsigned) {
-#endif
-			return static_cast<To>(_num);
+		else {
+			return _mm256_set1_epi32(static_cast<int>(_ch));
 		}
-
-		return _num;
 	}
 
-	// * square root using simd instruction
-	inline double sqrt_simd(const double _val) noexcept
+	// * lane wise compare for chars of any type, every byte of an equal char is set
+	template <class char_type>
+	inline __m256i cmpeq_simd(const __m256i _a, const __m256i _b) noexcept
 	{
-		const auto val = _mm_sqrt_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		if constexpr (sizeof(char_type) == 1) {
+			return _mm256_cmpeq_epi8(_a, _b);
+		}
+		else if constexpr (sizeof(char_type) == 2) {
+			return _mm256_cmpeq_epi16(_a, _b);
+		}
+		else {
+			return _mm256_cmpeq_epi32(_a, _b);
+		}
 	}
 
-	// * inverse square root using simd instruction
-	inline float inv_sqrt_simd(const float _val) noexcept
-	{
-		const auto val = _mm_rsqrt_ss(_mm_set_ss(_val));
-		return _mm_cvtss_f32(val);
-	}
+	// * needles up to this length use the simd first/last char filter, longer ones horspool
+	constexpr db::size_t find_simd_max_needle = 64;
 
-	// * pow using simd instruction
-	inline double pow_simd(const double _base, const double _expo) noexcept
+	// * constexpr substring search for any type of char
+	template <class char_type>
+	constexpr inline const char_type* raw_find(const char_type* _hay, const db::size_t _hay_len, const char_type* _needle, const db::size_t _needle_len) noexcept
 	{
-		const auto val = _mm_pow_pd(_mm_set_sd(_base), _mm_set_sd(_expo));
-		return _mm_cvtsd_f64(val);
+		if (_needle_len == 0) {
+			return _hay;
+		}
+		for (db::size_t i = 0; i + _needle_len <= _hay_len; ++i) {
+			if (_hay[i] == *_needle && db::raw_memcmp(_hay + i, _needle, _needle_len) == 0) {
+				return _hay + i;
+			}
+		}
+		return nullptr;
 	}
 
-	// * pow mod using simd instructions
-	inline double powm_simd(const double _base, const double _expo, const double _mod) noexcept
+	// * first match of _needle in _hay or nullptr, needles up to find_simd_max_needle chars, needs AVX2
+	// compares the first and last char of the needle against 32 byte blocks and only memcmps the candidates
+	template <class char_type>
+	inline const char_type* find_simd(const char_type* _hay, const db::size_t _hay_len, const char_type* _needle, const db::size_t _needle_len) noexcept
 	{
-		const auto val = _mm_fmod_pd(
-			_mm_pow_pd(_mm_set_sd(_base), _mm_set_sd(_expo)),
-			_mm_set_sd(_mod));
-		return _mm_cvtsd_f64(val);
+		static_assert(sizeof(char_type) == 1 || sizeof(char_type) == 2 || sizeof(char_type) == 4, "unsupported char type");
+
+		if (_needle_len == 0) {
+			return _hay;
+		}
+		if (_needle_len > _hay_len) {
+			return nullptr;
+		}
+
+		constexpr db::size_t lanes = 32U / sizeof(char_type);
+		constexpr db::uint32_t lane_bits = (1U << sizeof(char_type)) - 1U;
+		const db::size_t last = _needle_len - 1;
+		const __m256i first_ch = db::set1_simd(_needle[0]);
+		const __m256i last_ch = db::set1_simd(_needle[last]);
+
+		db::size_t i = 0;
+
+		// 32 byte blocks
+		for (; i + lanes + last <= _hay_len; i += lanes) {
+			const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_hay + i));
+			const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_hay + i + last));
+			db::uint32_t mask = static_cast<db::uint32_t>(_mm256_movemask_epi8(
+				_mm256_and_si256(db::cmpeq_simd<char_type>(first_ch, block_first), db::cmpeq_simd<char_type>(last_ch, block_last))
+			));
+
+			while (mask) {
+				const db::uint32_t bit = static_cast<db::uint32_t>(std::countr_zero(mask));
+				const char_type* candidate = _hay + i + bit / sizeof(char_type);
+				if (_needle_len <= 2 || db::memcmp(candidate + 1, _needle + 1, _needle_len - 2) == 0) {
+					return candidate;
+				}
+				mask &= ~(lane_bits << bit);
+			}
+		}
+
+		// check rest one by one
+		for (; i + last < _hay_len; ++i) {
+			if (_hay[i] == _needle[0] && _hay[i + last] == _needle[last] && db::memcmp(_hay + i, _needle, last) == 0) {
+				return _hay + i;
+			}
+		}
+
+		return nullptr;
 	}
 
-	// * atan using simd instruction
-	inline double atan_simd(const double _X) noexcept
+	// * precompiled needle for searching many haystacks
+	// keeps a copy of the needle and a horspool shift table for long needles
+	template <class char_type>
+	class searcher
 	{
-		const auto val = _mm_atan_pd(_mm_set_sd(_X));
-		return _mm_cvtsd_f64(val);
-	}
-	
-	// * atan2 using simd instruction
-	inline double atan2_simd(const double _X, const double _Y) noexcept
+	public:
+		searcher(const char_type* _needle, const db::size_t _len)
+			: _pattern(_needle, _needle + _len)
+		{
+			if (_len > db::find_simd_max_needle) {
+				std::fill(std::begin(_shift), std::end(_shift), _len);
+				for (db::size_t i = 0; i + 1 < _len; ++i) {
+					_shift[shift_index(_needle[i])] = _len - 1 - i;
+				}
+			}
+		}
+
+		explicit searcher(const std::basic_string_view<char_type> _needle)
+			: searcher(_needle.data(), _needle.size()) { }
+
+		const std::basic_string<char_type>& needle() const noexcept { return _pattern; }
+
+		// * first match in _hay[0, _len) or nullptr
+		const char_type* find(const char_type* _hay, const db::size_t _len) const noexcept
+		{
+			DB_INSTRUMENT_SCOPE(find, _len);
+
+			const db::size_t needle_len = _pattern.size();
+			if (needle_len <= db::find_simd_max_needle) {
+				return db::find_simd(_hay, _len, _pattern.data(), needle_len);
+			}
+
+			const char_type* needle = _pattern.data();
+			const char_type needle_last = needle[needle_len - 1];
+
+			for (db::size_t i = 0; i + needle_len <= _len;) {
+				const char_type ch = _hay[i + needle_len - 1];
+				if (ch == needle_last && db::memcmp(_hay + i, needle, needle_len - 1) == 0) {
+					return _hay + i;
+				}
+				i += _shift[shift_index(ch)];
+			}
+			return nullptr;
+		}
+
+		// * position of the first match or npos
+		db::size_t find(const std::basic_string_view<char_type> _hay) const noexcept
+		{
+			if (_pattern.empty()) {
+				return 0;
+			}
+			const char_type* res = find(_hay.data(), _hay.size());
+			return res ? static_cast<db::size_t>(res - _hay.data()) : std::basic_string_view<char_type>::npos;
+		}
+
+	private:
+		std::basic_string<char_type> _pattern;
+		db::size_t _shift[256]{};
+
+		// wider chars share buckets by their low byte, which only makes the shift smaller
+		static constexpr db::size_t shift_index(const char_type _ch) noexcept
+		{
+			return static_cast<db::size_t>(static_cast<std::make_unsigned_t<char_type>>(_ch) & 0xFFU);
+		}
+	};
+
+	// * substring search for any type of char, bounded inputs
+	template <class char_type>
+	constexpr inline const char_type* find(const char_type* _hay, const db::size_t _hay_len, const char_type* _needle, const db::size_t _needle_len)
 	{
-		const auto val = _mm_atan2_pd(_mm_set_sd(_X), _mm_set_sd(_Y));
-		return _mm_cvtsd_f64(val);
+		if (std::is_constant_evaluated()) {
+			return db::raw_find(_hay, _hay_len, _needle, _needle_len);
+		}
+		else if (_needle_len <= db::find_simd_max_needle) {
+			DB_INSTRUMENT_SCOPE(find, _hay_len);
+			return db::find_simd(_hay, _hay_len, _needle, _needle_len);
+		}
+		else {
+			return db::searcher<char_type>(_needle, _needle_len).find(_hay, _hay_len);
+		}
 	}
 
-	// * sin using simd instruction
-	inline double sin_simd(const double _val) noexcept
+	// * substring search for any type of char, position of the first match or npos
+	template <class char_type>
+	constexpr inline db::size_t find(const std::basic_string_view<char_type> _hay, const std::type_identity_t<std::basic_string_view<char_type>> _needle)
 	{
-		const auto val = _mm_sin_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		if (_needle.empty()) {
+			return 0;
+		}
+		const char_type* res = db::find(_hay.data(), _hay.size(), _needle.data(), _needle.size());
+		return res ? static_cast<db::size_t>(res - _hay.data()) : std::basic_string_view<char_type>::npos;
 	}
 
-	// * cos using simd instruction
-	inline double cos_simd(const double _val) noexcept
+	// * substring search in a string, position of the first match or npos
+	template <class char_type>
+	constexpr inline db::size_t find(const std::basic_string<char_type>& _hay, const std::type_identity_t<std::basic_string_view<char_type>> _needle)
 	{
-		const auto val = _mm_cos_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		return db::find(std::basic_string_view<char_type>(_hay), _needle);
 	}
 
-	// * tan using simd instruction
-	inline double tan_simd(const double _val) noexcept
+	// * substring search in a null terminated string, position of the first match or npos
+	template <class char_type>
+	constexpr inline db::size_t find(const char_type* _hay, const std::type_identity_t<std::basic_string_view<char_type>> _needle)
 	{
-		const auto val = _mm_tan_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		return db::find(std::basic_string_view<char_type>(_hay, db::strlen(_hay)), _needle);
 	}
 
-	// * tand using simd instruction
-	inline double tand_simd(const double _val) noexcept
+	// * strstr for any type of char
+	template <class char_type>
+	constexpr inline const char_type* strstr(const char_type* _hay, const char_type* _needle)
 	{
-		const auto val = _mm_tand_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		return db::find(_hay, db::strlen(_hay), _needle, db::strlen(_needle));
 	}
 
-	// * tanh using simd instruction
-	inline double tanh_simd(const double _val) noexcept
+	// * first char in [_begin, _end) the matcher accepts or _end, scans 32 byte blocks
+	template <class char_type, class Matcher>
+	inline const char_type* find_delim_simd(const char_type* _begin, const char_type* const _end, const Matcher& _match) noexcept
 	{
-		const auto val = _mm_tanh_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		constexpr db::size_t lanes = 32U / sizeof(char_type);
+
+		for (; static_cast<db::size_t>(_end - _begin) >= lanes; _begin += lanes) {
+			const db::uint32_t mask = _match.mask_simd(_begin);
+			if (mask) {
+				return _begin + std::countr_zero(mask) / sizeof(char_type);
+			}
+		}
+
+		for (; _begin != _end && !_match.match(*_begin); ++_begin);
+		return _begin;
 	}
 
-	// * acos using simd instruction
-	inline double acos_simd(const double _val) noexcept
+	// * single delimiter for db::split
+	template <class char_type>
+	struct split_char_matcher
 	{
-		const auto val = _mm_acos_pd(_mm_set_sd(_val));
+		char_type delim;
+
+		bool match(const char_type _ch) const noexcept { return _ch == delim; }
+
+		db::uint32_t mask_simd(const char_type* _str) const noexcept
+		{
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_str));
+			return static_cast<db::uint32_t>(_mm256_movemask_epi8(db::cmpeq_simd<char_type>(block, db::set1_simd(delim))));
+		}
+
+		const char_type* next(const char_type* _begin, const char_type* _end, std::basic_string_view<char_type>& _field) const noexcept
+		{
+			const char_type* delim_pos = db::find_delim_simd(_begin, _end, *this);
+			_field = std::basic_string_view<char_type>(_begin, static_cast<db::size_t>(delim_pos - _begin));
+			return delim_pos;
+		}
+	};
+
+	// * any char of a delimiter set for db::split
+	template <class char_type>
+	struct split_set_matcher
+	{
+		std::basic_string_view<char_type> delims;
+
+		bool match(const char_type _ch) const noexcept { return delims.find(_ch) != delims.npos; }
+
+		db::uint32_t mask_simd(const char_type* _str) const noexcept
+		{
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_str));
+			__m256i hits = _mm256_setzero_si256();
+			for (const char_type delim : delims) {
+				hits = _mm256_or_si256(hits, db::cmpeq_simd<char_type>(block, db::set1_simd(delim)));
+			}
+			return static_cast<db::uint32_t>(_mm256_movemask_epi8(hits));
+		}
+
+		const char_type* next(const char_type* _begin, const char_type* _end, std::basic_string_view<char_type>& _field) const noexcept
+		{
+			const char_type* delim_pos = db::find_delim_simd(_begin, _end, *this);
+			_field = std::basic_string_view<char_type>(_begin, static_cast<db::size_t>(delim_pos - _begin));
+			return delim_pos;
+		}
+	};
+
+	// * csv fields of one record for db::split_csv
+	// quoted fields come without their outer quotes, doubled quotes inside stay as they are
+	template <class char_type>
+	struct split_csv_matcher
+	{
+		db::split_char_matcher<char_type> delim;
+		db::split_char_matcher<char_type> quote;
+
+		const char_type* next(const char_type* _begin, const char_type* _end, std::basic_string_view<char_type>& _field) const noexcept
+		{
+			if (_begin == _end || *_begin != quote.delim) {
+				return delim.next(_begin, _end, _field);
+			}
+
+			// Closing quote is the first one not followed by another quote
+			const char_type* close = _begin + 1;
+			for (;;) {
+				close = db::find_delim_simd(close, _end, quote);
+				if (close + 1 < _end && close[1] == quote.delim) {
+					close += 2;
+					continue;
+				}
+				break;
+			}
+
+			_field = std::basic_string_view<char_type>(_begin + 1, static_cast<db::size_t>(close - _begin - 1));
+			return close == _end ? _end : db::find_delim_simd(close + 1, _end, delim);
+		}
+	};
+
+	// * lazy range of string_views into the split string, nothing is copied
+	// an empty string has no fields, otherwise n delimiters give n + 1 fields
+	template <class char_type, class Matcher>
+	class split_range
+	{
+	public:
+		class iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::basic_string_view<char_type>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = const value_type&;
+
+			iterator() noexcept = default;
+
+			iterator(const Matcher* _matcher, const char_type* _first, const char_type* _last) noexcept
+				: _match(_matcher), _pos(_last), _end(_last), _done(_first == _last)
+			{
+				if (!_done) {
+					_pos = _match->next(_first, _end, _field);
+				}
+			}
+
+			reference operator*() const noexcept { return _field; }
+			pointer operator->() const noexcept { return &_field; }
+
+			iterator& operator++() noexcept
+			{
+				if (_pos == _end) {
+					_done = true;
+				}
+				else {
+					_pos = _match->next(_pos + 1, _end, _field);
+				}
+				return *this;
+			}
+
+			iterator operator++(int) noexcept
+			{
+				iterator tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			friend bool operator==(const iterator& _lhs, const iterator& _rhs) noexcept
+			{
+				return _lhs._done == _rhs._done && (_lhs._done || _lhs._pos == _rhs._pos);
+			}
+
+			friend bool operator!=(const iterator& _lhs, const iterator& _rhs) noexcept { return !(_lhs == _rhs); }
+
+		private:
+			const Matcher* _match = nullptr;
+			const char_type* _pos = nullptr;
+			const char_type* _end = nullptr;
+			std::basic_string_view<char_type> _field;
+			bool _done = true;
+		};
+
+		split_range(const std::basic_string_view<char_type> _input, const Matcher& _matcher) noexcept
+			: _str(_input), _match(_matcher) { }
+
+		iterator begin() const noexcept { return iterator(&_match, _str.data(), _str.data() + _str.size()); }
+		iterator end() const noexcept { return iterator(); }
+
+	private:
+		std::basic_string_view<char_type> _str;
+		Matcher _match;
+	};
+
+	// * split on one delimiter, _str has to outlive the range
+	template <class char_type>
+	inline db::split_range<char_type, db::split_char_matcher<char_type>> split(const std::basic_string_view<char_type> _str, const std::type_identity_t<char_type> _delim) noexcept
+	{
+		return { _str, db::split_char_matcher<char_type>{ _delim } };
+	}
+
+	// * split on any char of _delims, _str and _delims have to outlive the range
+	// a temporary std::string as _delims dangles before the loop body runs
+	template <class char_type>
+	inline db::split_range<char_type, db::split_set_matcher<char_type>> split(const std::basic_string_view<char_type> _str, const std::type_identity_t<std::basic_string_view<char_type>> _delims) noexcept
+	{
+		return { _str, db::split_set_matcher<char_type>{ _delims } };
+	}
+
+	// * split one csv record, newlines are ordinary chars so split lines first, _str has to outlive the range
+	template <class char_type>
+	inline db::split_range<char_type, db::split_csv_matcher<char_type>> split_csv(const std::basic_string_view<char_type> _str, const std::type_identity_t<char_type> _delim = ',', const std::type_identity_t<char_type> _quote = '"') noexcept
+	{
+		return { _str, db::split_csv_matcher<char_type>{ { _delim }, { _quote } } };
+	}
+
+	// * split a string, _str has to outlive the range, _delims too for the set version
+	template <class char_type>
+	inline db::split_range<char_type, db::split_char_matcher<char_type>> split(const std::basic_string<char_type>& _str, const std::type_identity_t<char_type> _delim) noexcept
+	{
+		return db::split(std::basic_string_view<char_type>(_str), _delim);
+	}
+
+	template <class char_type>
+	inline db::split_range<char_type, db::split_set_matcher<char_type>> split(const std::basic_string<char_type>& _str, const std::type_identity_t<std::basic_string_view<char_type>> _delims) noexcept
+	{
+		return db::split(std::basic_string_view<char_type>(_str), _delims);
+	}
+
+	template <class char_type>
+	inline db::split_range<char_type, db::split_csv_matcher<char_type>> split_csv(const std::basic_string<char_type>& _str, const std::type_identity_t<char_type> _delim = ',', const std::type_identity_t<char_type> _quote = '"') noexcept
+	{
+		return db::split_csv(std::basic_string_view<char_type>(_str), _delim, _quote);
+	}
+
+	// * temporary strings are gone before the range is used, split a named string or a string_view
+	template <class char_type>
+	void split(std::basic_string<char_type>&& _str, const std::type_identity_t<char_type> _delim) = delete;
+
+	template <class char_type>
+	void split(std::basic_string<char_type>&& _str, const std::type_identity_t<std::basic_string_view<char_type>> _delims) = delete;
+
+	template <class char_type>
+	void split_csv(std::basic_string<char_type>&& _str, const std::type_identity_t<char_type> _delim = ',', const std::type_identity_t<char_type> _quote = '"') = delete;
+
+	// * split a null terminated string, _str has to outlive the range, _delims too for the set version
+	template <class char_type>
+	inline db::split_range<char_type, db::split_char_matcher<char_type>> split(const char_type* _str, const std::type_identity_t<char_type> _delim) noexcept
+	{
+		return db::split(std::basic_string_view<char_type>(_str, db::strlen(_str)), _delim);
+	}
+
+	template <class char_type>
+	inline db::split_range<char_type, db::split_set_matcher<char_type>> split(const char_type* _str, const std::type_identity_t<std::basic_string_view<char_type>> _delims) noexcept
+	{
+		return db::split(std::basic_string_view<char_type>(_str, db::strlen(_str)), _delims);
+	}
+
+	template <class char_type>
+	inline db::split_range<char_type, db::split_csv_matcher<char_type>> split_csv(const char_type* _str, const std::type_identity_t<char_type> _delim = ',', const std::type_identity_t<char_type> _quote = '"') noexcept
+	{
+		return db::split_csv(std::basic_string_view<char_type>(_str, db::strlen(_str)), _delim, _quote);
+	}
+
+	// * batch split, writes the end offset of every field into _offsets and returns the number of fields
+	// field i is [_offsets[i - 1] + 1, _offsets[i]), only the first _max_offsets offsets are written
+	// so a result above _max_offsets means the output was cut off and the rest of _str was only counted
+	template <class char_type, class Matcher>
+	inline db::size_t raw_split_offsets(const std::basic_string_view<char_type> _str, const Matcher& _match, db::size_t* _offsets, const db::size_t _max_offsets) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(split, _str.size());
+
+		constexpr db::size_t lanes = 32U / sizeof(char_type);
+		constexpr db::uint32_t lane_bits = (1U << sizeof(char_type)) - 1U;
+
+		if (_str.empty()) {
+			return 0;
+		}
+
+		const char_type* const data = _str.data();
+		const db::size_t len = _str.size();
+		db::size_t count = 0;
+		db::size_t i = 0;
+
+		// Take every delimiter of a block instead of stopping at the first one
+		for (; i + lanes <= len; i += lanes) {
+			db::uint32_t mask = _match.mask_simd(data + i);
+			if (count >= _max_offsets) {
+				count += static_cast<db::size_t>(std::popcount(mask)) / sizeof(char_type);
+				continue;
+			}
+			while (mask) {
+				const db::uint32_t bit = static_cast<db::uint32_t>(std::countr_zero(mask));
+				if (count < _max_offsets) {
+					_offsets[count] = i + bit / sizeof(char_type);
+				}
+				++count;
+				mask &= ~(lane_bits << bit);
+			}
+		}
+
+		for (; i != len; ++i) {
+			if (_match.match(data[i])) {
+				if (count < _max_offsets) {
+					_offsets[count] = i;
+				}
+				++count;
+			}
+		}
+
+		if (count < _max_offsets) {
+			_offsets[count] = len;
+		}
+		return count + 1;
+	}
+
+	// * batch split on one delimiter
+	template <class char_type>
+	inline db::size_t split_offsets(const std::basic_string_view<char_type> _str, const std::type_identity_t<char_type> _delim, db::size_t* _offsets, const db::size_t _max_offsets) noexcept
+	{
+		return db::raw_split_offsets(_str, db::split_char_matcher<char_type>{ _delim }, _offsets, _max_offsets);
+	}
+
+	// * batch split on any char of _delims
+	template <class char_type>
+	inline db::size_t split_offsets(const std::basic_string_view<char_type> _str, const std::type_identity_t<std::basic_string_view<char_type>> _delims, db::size_t* _offsets, const db::size_t _max_offsets) noexcept
+	{
+		return db::raw_split_offsets(_str, db::split_set_matcher<char_type>{ _delims }, _offsets, _max_offsets);
+	}
+
+	// * batch split of a string or a null terminated string
+	template <class char_type>
+	inline db::size_t split_offsets(const std::basic_string<char_type>& _str, const std::type_identity_t<char_type> _delim, db::size_t* _offsets, const db::size_t _max_offsets) noexcept
+	{
+		return db::split_offsets(std::basic_string_view<char_type>(_str), _delim, _offsets, _max_offsets);
+	}
+
+	template <class char_type>
+	inline db::size_t split_offsets(const std::basic_string<char_type>& _str, const std::type_identity_t<std::basic_string_view<char_type>> _delims, db::size_t* _offsets, const db::size_t _max_offsets) noexcept
+	{
+		return db::split_offsets(std::basic_string_view<char_type>(_str), _delims, _offsets, _max_offsets);
+	}
+
+	template <class char_type>
+	inline db::size_t split_offsets(const char_type* _str, const std::type_identity_t<char_type> _delim, db::size_t* _offsets, const db::size_t _max_offsets) noexcept
+	{
+		return db::split_offsets(std::basic_string_view<char_type>(_str, db::strlen(_str)), _delim, _offsets, _max_offsets);
+	}
+
+	template <class char_type>
+	inline db::size_t split_offsets(const char_type* _str, const std::type_identity_t<std::basic_string_view<char_type>> _delims, db::size_t* _offsets, const db::size_t _max_offsets) noexcept
+	{
+		return db::split_offsets(std::basic_string_view<char_type>(_str, db::strlen(_str)), _delims, _offsets, _max_offsets);
+	}
+}
+
+// NUMBER OPERATIONS / MATH
+namespace db
+{
+	// * Signed to Unsigned number
+	template <class From, class To = std::make_unsigned_t<From>>
+	constexpr inline To to_unsigned(const From _num) noexcept
+	{
+		constexpr bool same_type = std::is_same_v<From, To>;
+		constexpr bool can_negative = !std::is_unsigned_v<From>;
+#if _HAS_CXX17
+		if constexpr (can_negative && !same_type) {
+#else
+		if (can_negative) {
+#endif
+			if (_num < 0) {
+				return (static_cast<From>(0) - static_cast<To>(_num));
+			}
+		}
+		return _num;
+		}
+
+	// * Unsigned to Signed number
+	template <class To = db::int64_t, class From>
+	constexpr inline To to_signed(const From _num) noexcept
+	{
+		constexpr bool is_unsigned = std::is_unsigned_v<From>;
+#if _HAS_CXX17
+		if constexpr(is_unsigned) {
+#else 
+		if (is_unsigned) {
+#endif
+			return static_cast<To>(_num);
+		}
+
+		return _num;
+	}
+
+	// * square root using simd instruction
+	inline double sqrt_simd(const double _val) noexcept
+	{
+		const auto val = _mm_sqrt_pd(_mm_set_sd(_val));
 		return _mm_cvtsd_f64(val);
 	}
 
-	// * asin using simd instruction
-	inline double asin_simd(const double _val) noexcept
+	// * inverse square root using simd instruction
+	inline float inv_sqrt_simd(const float _val) noexcept
 	{
-		const auto val = _mm_asin_pd(_mm_set_sd(_val));
+		const auto val = _mm_rsqrt_ss(_mm_set_ss(_val));
+		return _mm_cvtss_f32(val);
+	}
+
+	// * pow using simd instruction
+	inline double pow_simd(const double _base, const double _expo) noexcept
+	{
+		const auto val = _mm_pow_pd(_mm_set_sd(_base), _mm_set_sd(_expo));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * pow mod using simd instructions
+	inline double powm_simd(const double _base, const double _expo, const double _mod) noexcept
+	{
+		const auto val = _mm_fmod_pd(
+			_mm_pow_pd(_mm_set_sd(_base), _mm_set_sd(_expo)),
+			_mm_set_sd(_mod));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * atan using simd instruction
+	inline double atan_simd(const double _X) noexcept
+	{
+		const auto val = _mm_atan_pd(_mm_set_sd(_X));
 		return _mm_cvtsd_f64(val);
 	}
 	
-	// * hypot using simd instruction
-	inline double hypot_simd(const double _X, const double _Y) noexcept
+	// * atan2 using simd instruction
+	inline double atan2_simd(const double _X, const double _Y) noexcept
 	{
-		const auto val = _mm_hypot_pd(_mm_set_sd(_X), _mm_set_sd(_Y));
+		const auto val = _mm_atan2_pd(_mm_set_sd(_X), _mm_set_sd(_Y));
 		return _mm_cvtsd_f64(val);
 	}
 
-	// * log using simd instruction
-	inline double log_simd(const double _val) noexcept
+	// * sin using simd instruction
+	inline double sin_simd(const double _val) noexcept
 	{
-		const auto val = _mm_log_pd(_mm_set_sd(_val));
+		const auto val = _mm_sin_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * cos using simd instruction
+	inline double cos_simd(const double _val) noexcept
+	{
+		const auto val = _mm_cos_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * tan using simd instruction
+	inline double tan_simd(const double _val) noexcept
+	{
+		const auto val = _mm_tan_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * tand using simd instruction
+	inline double tand_simd(const double _val) noexcept
+	{
+		const auto val = _mm_tand_pd(_mm_set_sd(_val));
 		return _mm_cvtsd_f64(val);
 	}
 
-	// * log2 using simd instruction
-	inline double log2_simd(const double _val) noexcept
+	// * tanh using simd instruction
+	inline double tanh_simd(const double _val) noexcept
+	{
+		const auto val = _mm_tanh_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * acos using simd instruction
+	inline double acos_simd(const double _val) noexcept
+	{
+		const auto val = _mm_acos_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * asin using simd instruction
+	inline double asin_simd(const double _val) noexcept
+	{
+		const auto val = _mm_asin_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+	
+	// * hypot using simd instruction
+	inline double hypot_simd(const double _X, const double _Y) noexcept
+	{
+		const auto val = _mm_hypot_pd(_mm_set_sd(_X), _mm_set_sd(_Y));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * log using simd instruction
+	inline double log_simd(const double _val) noexcept
+	{
+		const auto val = _mm_log_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * log2 using simd instruction
+	inline double log2_simd(const double _val) noexcept
+	{
+		const auto val = _mm_log2_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * log10 using simd instruction
+	inline double log10_simd(const double _val) noexcept
+	{
+		const auto val = _mm_log10_pd(_mm_set_sd(_val));
+		return _mm_cvtsd_f64(val);
+	}
+
+	// * float math traded for speed, Bits is the wanted precision in mantissa bits (1 - 21)
+	// polynomial degree and newton-raphson steps are picked at compile time from Bits
+	// every function has a scalar float and a packed __m256 version
+	// exp needs -87.3 <= x <= 88.3, log needs normal x > 0, sin loses precision above |x| ~ 1e5
+	// max error over every float in those domains (sin up to |x| = 1e5), relative except sin which is absolute
+	//   Bits   exp      log      sin      inv_sqrt
+	//    8     7.9e-4   4.2e-4   1.6e-4   3.3e-4
+	//   12     5.6e-5   4.0e-6   3.8e-6   2.9e-7
+	//   16     3.3e-6   4.0e-6   3.8e-6   2.9e-7
+	//   20     2.3e-7   3.7e-7   1.9e-7   2.9e-7
+	//   21     2.3e-7   3.7e-7   1.9e-7   2.9e-7
+	template <db::uint32_t Bits>
+	struct approx
+	{
+		// 22 and 23 bits would need correctly rounded float math, rcp_ps and rsqrt_ps with newton-raphson stop short of it
+		static_assert(Bits >= 1 && Bits <= 21, "approx supports 1 to 21 bits of precision");
+
+		// first polynomial degree whose truncation error stays below 2^-(Bits + 1)
+		// _step is the degree step, _first the degree of the first term
+		static constexpr db::uint32_t degree(const double _range, const db::uint32_t _first, const db::uint32_t _step) noexcept
+		{
+			const double limit = 1.0 / static_cast<double>(1ULL << (Bits + 1));
+			db::uint32_t deg = _first;
+			for (;; deg += _step) {
+				// next taylor term, _range^(deg + _step) / (deg + _step)!
+				double term = 1.0;
+				for (db::uint32_t i = 1; i <= deg + _step; ++i) {
+					term *= _range / i;
+				}
+				if (term <= limit) {
+					return deg;
+				}
+			}
+		}
+
+		static constexpr db::uint32_t exp_degree = degree(0.3466, 1, 1);     // e^r with |r| <= ln2 / 2
+		static constexpr db::uint32_t log_degree = [] {                      // 2 atanh(s) with |s| <= 0.1716
+			const double limit = 1.0 / static_cast<double>(1ULL << (Bits + 1));
+			db::uint32_t deg = 1;
+			// the next term relative to 2 atanh(s) ~ 2s, log(m) is near 0 so the bound has to be relative
+			double term = 0.1716 * 0.1716;
+			for (; term / (deg + 2) > limit; deg += 2) {
+				term *= 0.1716 * 0.1716;
+			}
+			return deg;
+		}();
+		static constexpr db::uint32_t sin_degree = degree(1.5708, 1, 2);     // sin(r) with |r| <= pi / 2
+		static constexpr db::uint32_t rcp_steps = Bits > 11 ? 1 : 0;        // rcp_ps is good for 12 bits
+		static constexpr db::uint32_t inv_sqrt_steps = Bits > 11 ? 1 : 0;   // so is rsqrt_ps
+
+		// horner's method over the coefficients of one term per _step degrees
+		template <std::size_t N>
+		static inline __m256 poly(const __m256 _x, const std::array<float, N>& _coeffs) noexcept
+		{
+			__m256 res = _mm256_set1_ps(_coeffs[N - 1]);
+			for (std::size_t i = N - 1; i-- > 0;) {
+				res = _mm256_fmadd_ps(res, _x, _mm256_set1_ps(_coeffs[i]));
+			}
+			return res;
+		}
+
+		static inline __m256 rcp(const __m256 _x) noexcept
+		{
+			__m256 res = _mm256_rcp_ps(_x);
+			for (db::uint32_t i = 0; i != rcp_steps; ++i) {
+				// res * (2 - x * res)
+				res = _mm256_mul_ps(res, _mm256_fnmadd_ps(_x, res, _mm256_set1_ps(2.0f)));
+			}
+			return res;
+		}
+
+		static inline __m256 exp(__m256 _x) noexcept
+		{
+			static constexpr auto coeffs = [] {
+				std::array<float, exp_degree + 1> res{};
+				double fact = 1.0;
+				for (db::uint32_t i = 0; i <= exp_degree; ++i) {
+					fact *= i ? i : 1;
+					res[i] = static_cast<float>(1.0 / fact);
+				}
+				return res;
+			}();
+
+			// e^x = 2^n * e^r with x = n * ln2 + r
+			_x = _mm256_min_ps(_mm256_max_ps(_x, _mm256_set1_ps(-87.3f)), _mm256_set1_ps(88.3f));
+			const __m256 n = _mm256_round_ps(_mm256_mul_ps(_x, _mm256_set1_ps(1.44269504f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693145752f), _x);
+			r = _mm256_fnmadd_ps(n, _mm256_set1_ps(1.42860677e-6f), r);
+
+			const __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+			return _mm256_mul_ps(poly(r, coeffs), _mm256_castsi256_ps(scale));
+		}
+
+		static inline __m256 log(const __m256 _x) noexcept
+		{
+			static constexpr auto coeffs = [] {
+				std::array<float, log_degree / 2 + 1> res{};
+				for (db::uint32_t i = 0; i != res.size(); ++i) {
+					res[i] = 2.0f / static_cast<float>(i * 2 + 1);
+				}
+				return res;
+			}();
+
+			// log(x) = e * ln2 + log(m) with m in [sqrt(1/2), sqrt(2))
+			const __m256i bits = _mm256_castps_si256(_x);
+			__m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+			__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+
+			const __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+			m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+			e = _mm256_add_ps(e, _mm256_and_ps(big, _mm256_set1_ps(1.0f)));
+
+			// log(m) = 2 atanh(s) with s = (m - 1) / (m + 1)
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 s = _mm256_mul_ps(_mm256_sub_ps(m, one), rcp(_mm256_add_ps(m, one)));
+			const __m256 res = _mm256_mul_ps(poly(_mm256_mul_ps(s, s), coeffs), s);
+			return _mm256_fmadd_ps(e, _mm256_set1_ps(0.693147181f), res);
+		}
+
+		static inline __m256 sin(const __m256 _x) noexcept
+		{
+			static constexpr auto coeffs = [] {
+				std::array<float, sin_degree / 2 + 1> res{};
+				double fact = 1.0;
+				for (db::uint32_t i = 0; i != res.size(); ++i) {
+					fact *= i ? static_cast<double>(i * 2) * (i * 2 + 1) : 1.0;
+					res[i] = static_cast<float>((i & 1 ? -1.0 : 1.0) / fact);
+				}
+				return res;
+			}();
+
+			// sin(x) = (-1)^k * sin(r) with x = k * pi + r
+			const __m256 k = _mm256_round_ps(_mm256_mul_ps(_x, _mm256_set1_ps(0.318309886f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+			__m256 r = _mm256_fnmadd_ps(k, _mm256_set1_ps(3.14159274f), _x);
+			r = _mm256_fnmadd_ps(k, _mm256_set1_ps(-8.74227766e-8f), r);
+
+			const __m256 sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtps_epi32(k), 31));
+			const __m256 res = _mm256_mul_ps(poly(_mm256_mul_ps(r, r), coeffs), r);
+			return _mm256_xor_ps(res, sign);
+		}
+
+		static inline __m256 inv_sqrt(const __m256 _x) noexcept
+		{
+			__m256 res = _mm256_rsqrt_ps(_x);
+			for (db::uint32_t i = 0; i != inv_sqrt_steps; ++i) {
+				// res * (1.5 - 0.5 * x * res^2)
+				const __m256 half_x_res = _mm256_mul_ps(_mm256_mul_ps(_x, _mm256_set1_ps(0.5f)), res);
+				res = _mm256_mul_ps(res, _mm256_fnmadd_ps(half_x_res, res, _mm256_set1_ps(1.5f)));
+			}
+			return res;
+		}
+
+		static inline float exp(const float _x) noexcept { return _mm256_cvtss_f32(exp(_mm256_set1_ps(_x))); }
+		static inline float log(const float _x) noexcept { return _mm256_cvtss_f32(log(_mm256_set1_ps(_x))); }
+		static inline float sin(const float _x) noexcept { return _mm256_cvtss_f32(sin(_mm256_set1_ps(_x))); }
+		static inline float inv_sqrt(const float _x) noexcept { return _mm256_cvtss_f32(inv_sqrt(_mm256_set1_ps(_x))); }
+	};
+
+	// * pow, use db::big_uint as Base when the result does not fit into 64 bit
+	template<class Base, class Expo>
+	constexpr inline auto pow(Base _base, Expo _expo)
+	{
+		DB_INSTRUMENT_SCOPE(pow, _expo);
+
+		using result = db::enable_if_else <std::is_integral_v<Base>,
+			typename db::enable_if_else<std::is_unsigned_v<Base>,
+			db::uint64_t,
+			db::int64_t>::type,
+			Base
+		>::type;
+
+		result res = 1;
+
+		while (_expo > 0) {
+			if (_expo & 1) {
+				res *= _base;
+			}
+			_base *= _base;
+			_expo >>= 1;
+		}
+
+		return res;
+	}
+
+	// * pow mod, use db::big_uint as Base when _mod does not fit into 32 bit
+	template<class Base, class Expo, class Mod>
+	constexpr inline auto powm(Base _base, Expo _expo, const Mod& _mod)
+	{
+		DB_INSTRUMENT_SCOPE(powm, _expo);
+
+		using result = db::enable_if_else <std::is_integral_v<Base>,
+			typename db::enable_if_else<std::is_unsigned_v<Base>,
+			db::uint64_t,
+			db::int64_t>::type,
+			Base
+		>::type;
+
+		result res = 1;
+
+		while (_expo > 0) {
+			if (_expo & 1) {
+				res = (res * _base) % _mod;
+			}
+			_base = (_base * _base) % _mod;
+			_expo >>= 1;
+		}
+
+		return res;
+	}
+}
+
+// BIG NUMBERS
+namespace db
+{
+	// * arbitrary-precision unsigned integer
+	// limbs are stored little endian, the first inline_limbs live inside the object
+	class big_uint
+	{
+	public:
+		static constexpr db::size_t inline_limbs = 4;          // 256 bit without heap allocation
+		static constexpr db::size_t karatsuba_threshold = 32;  // limbs, below that schoolbook is faster
+
+		big_uint() noexcept
+			: _limbs(_small), _size(0), _cap(inline_limbs), _small{} { }
+
+		big_uint(const db::uint64_t _num) noexcept
+			: _limbs(_small), _size(_num != 0), _cap(inline_limbs), _small{ _num } { }
+
+		big_uint(const big_uint& _other)
+			: big_uint()
+		{
+			assign(_other._limbs, _other._size);
+		}
+
+		big_uint(big_uint&& _other) noexcept
+			: big_uint()
+		{
+			swap(_other);
+		}
+
+		~big_uint()
+		{
+			if (_limbs != _small) {
+				delete[] _limbs;
+			}
+		}
+
+		big_uint& operator=(const big_uint& _other)
+		{
+			if (this != &_other) {
+				assign(_other._limbs, _other._size);
+			}
+			return *this;
+		}
+
+		big_uint& operator=(big_uint&& _other) noexcept
+		{
+			swap(_other);
+			return *this;
+		}
+
+		void swap(big_uint& _other) noexcept
+		{
+			if (_limbs != _small && _other._limbs != _other._small) {
+				std::swap(_limbs, _other._limbs);
+			}
+			else if (_limbs != _small) {
+				db::memcpy(_small, _other._limbs, _other._size);
+				_other._limbs = _limbs;
+				_limbs = _small;
+			}
+			else if (_other._limbs != _other._small) {
+				db::memcpy(_other._small, _limbs, _size);
+				_limbs = _other._limbs;
+				_other._limbs = _other._small;
+			}
+			else {
+				std::swap(_small, _other._small);
+			}
+			std::swap(_size, _other._size);
+			std::swap(_cap, _other._cap);
+		}
+
+		// * number of used 64 bit limbs
+		db::size_t limbs() const noexcept { return _size; }
+
+		// * little endian limbs
+		const db::uint64_t* data() const noexcept { return _limbs; }
+
+		// * number of significant bits
+		db::size_t bit_width() const noexcept
+		{
+			if (_size == 0) {
+				return 0;
+			}
+			return _size * 64U - static_cast<db::size_t>(std::countl_zero(_limbs[_size - 1]));
+		}
+
+		bool is_zero() const noexcept { return _size == 0; }
+
+		explicit operator bool() const noexcept { return _size != 0; }
+
+		// * lowest 64 bits
+		explicit operator db::uint64_t() const noexcept { return _size ? _limbs[0] : 0; }
+
+		// * *this = *this * _mul + _add
+		big_uint& mul_add(const db::uint64_t _mul, const db::uint64_t _add)
+		{
+			db::uint64_t carry = _add;
+			for (db::size_t i = 0; i != _size; ++i) {
+				db::uint64_t hi;
+				db::uint64_t lo = mul_limb(_limbs[i], _mul, &hi);
+				hi += add_carry(0, lo, carry, &_limbs[i]);
+				carry = hi;
+			}
+			if (carry) {
+				push_back(carry);
+			}
+			trim();
+			return *this;
+		}
+
+		// * *this /= _div and returns the remainder
+		db::uint64_t div_small(const db::uint64_t _div)
+		{
+			if (_div == 0) {
+				throw std::invalid_argument("division by zero");
+			}
+			const db::uint64_t rem = raw_divmod_1(_limbs, _limbs, _size, _div);
+			trim();
+			return rem;
+		}
+
+		// * quotient and remainder in one pass
+		static void divmod(const big_uint& _num, const big_uint& _div, big_uint& _quot, big_uint& _rem)
+		{
+			DB_INSTRUMENT_SCOPE(big_uint_divmod, _num._size);
+
+			if (_div._size == 0) {
+				throw std::invalid_argument("division by zero");
+			}
+			if (raw_cmp(_num._limbs, _num._size, _div._limbs, _div._size) < 0) {
+				_rem = _num;
+				_quot = big_uint();
+				return;
+			}
+			if (_div._size == 1) {
+				big_uint quot;
+				quot.resize(_num._size);
+				const db::uint64_t rem = raw_divmod_1(quot._limbs, _num._limbs, _num._size, _div._limbs[0]);
+				quot.trim();
+				_quot = std::move(quot);
+				_rem = big_uint(rem);
+				return;
+			}
+
+			big_uint quot;
+			big_uint rem;
+			quot.resize(_num._size - _div._size + 1);
+			rem.resize(_div._size);
+			raw_divmod(quot._limbs, rem._limbs, _num._limbs, _num._size, _div._limbs, _div._size);
+			quot.trim();
+			rem.trim();
+			_quot = std::move(quot);
+			_rem = std::move(rem);
+		}
+
+		big_uint& operator+=(const big_uint& _other)
+		{
+			const db::size_t len = std::max(_size, _other._size);
+			resize(len);
+			if (raw_add_to(_limbs, len, _other._limbs, _other._size)) {
+				push_back(1);
+			}
+			return *this;
+		}
+
+		// * throws on underflow, big_uint has no sign
+		big_uint& operator-=(const big_uint& _other)
+		{
+			if (raw_cmp(_limbs, _size, _other._limbs, _other._size) < 0) {
+				throw std::invalid_argument("big_uint subtraction underflow");
+			}
+			raw_sub_from(_limbs, _size, _other._limbs, _other._size);
+			trim();
+			return *this;
+		}
+
+		big_uint& operator*=(const big_uint& _other)
+		{
+			*this = *this * _other;
+			return *this;
+		}
+
+		big_uint& operator/=(const big_uint& _other)
+		{
+			big_uint rem;
+			divmod(*this, _other, *this, rem);
+			return *this;
+		}
+
+		big_uint& operator%=(const big_uint& _other)
+		{
+			big_uint quot;
+			divmod(*this, _other, quot, *this);
+			return *this;
+		}
+
+		big_uint& operator<<=(const db::size_t _shift)
+		{
+			if (_size == 0 || _shift == 0) {
+				return *this;
+			}
+			const db::size_t limbs = _shift / 64U;
+			const db::uint32_t bits = static_cast<db::uint32_t>(_shift % 64U);
+			const db::size_t old_size = _size;
+			resize(old_size + limbs + 1);
+			for (db::size_t i = old_size; i-- != 0;) {
+				const db::uint64_t cur = _limbs[i];
+				if (bits) {
+					_limbs[i + limbs + 1] |= cur >> (64U - bits);
+				}
+				_limbs[i + limbs] = cur << bits;
+			}
+			std::fill(_limbs, _limbs + limbs, 0ULL);
+			trim();
+			return *this;
+		}
+
+		big_uint& operator>>=(const db::size_t _shift)
+		{
+			const db::size_t limbs = _shift / 64U;
+			const db::uint32_t bits = static_cast<db::uint32_t>(_shift % 64U);
+			if (limbs >= _size) {
+				_size = 0;
+				return *this;
+			}
+			const db::size_t new_size = _size - limbs;
+			for (db::size_t i = 0; i != new_size; ++i) {
+				db::uint64_t cur = _limbs[i + limbs] >> bits;
+				if (bits && i + limbs + 1 < _size) {
+					cur |= _limbs[i + limbs + 1] << (64U - bits);
+				}
+				_limbs[i] = cur;
+			}
+			_size = new_size;
+			trim();
+			return *this;
+		}
+
+		friend big_uint operator+(big_uint _lhs, const big_uint& _rhs) { return _lhs += _rhs; }
+		friend big_uint operator-(big_uint _lhs, const big_uint& _rhs) { return _lhs -= _rhs; }
+		friend big_uint operator/(big_uint _lhs, const big_uint& _rhs) { return _lhs /= _rhs; }
+		friend big_uint operator%(big_uint _lhs, const big_uint& _rhs) { return _lhs %= _rhs; }
+		friend big_uint operator<<(big_uint _lhs, const db::size_t _shift) { return _lhs <<= _shift; }
+		friend big_uint operator>>(big_uint _lhs, const db::size_t _shift) { return _lhs >>= _shift; }
+
+		friend big_uint operator*(const big_uint& _lhs, const big_uint& _rhs)
+		{
+			DB_INSTRUMENT_SCOPE(big_uint_mul, std::max(_lhs._size, _rhs._size));
+
+			big_uint res;
+			if (_lhs._size == 0 || _rhs._size == 0) {
+				return res;
+			}
+			res.resize(_lhs._size + _rhs._size);
+			raw_mul(res._limbs, _lhs._limbs, _lhs._size, _rhs._limbs, _rhs._size);
+			res.trim();
+			return res;
+		}
+
+		// * lowest bits only, enough for `_expo & 1`
+		friend db::uint64_t operator&(const big_uint& _lhs, const db::uint64_t _rhs) noexcept
+		{
+			return _lhs._size ? (_lhs._limbs[0] & _rhs) : 0;
+		}
+
+		friend bool operator==(const big_uint& _lhs, const big_uint& _rhs) noexcept { return raw_cmp(_lhs._limbs, _lhs._size, _rhs._limbs, _rhs._size) == 0; }
+		friend bool operator!=(const big_uint& _lhs, const big_uint& _rhs) noexcept { return raw_cmp(_lhs._limbs, _lhs._size, _rhs._limbs, _rhs._size) != 0; }
+		friend bool operator<(const big_uint& _lhs, const big_uint& _rhs) noexcept { return raw_cmp(_lhs._limbs, _lhs._size, _rhs._limbs, _rhs._size) < 0; }
+		friend bool operator<=(const big_uint& _lhs, const big_uint& _rhs) noexcept { return raw_cmp(_lhs._limbs, _lhs._size, _rhs._limbs, _rhs._size) <= 0; }
+		friend bool operator>(const big_uint& _lhs, const big_uint& _rhs) noexcept { return raw_cmp(_lhs._limbs, _lhs._size, _rhs._limbs, _rhs._size) > 0; }
+		friend bool operator>=(const big_uint& _lhs, const big_uint& _rhs) noexcept { return raw_cmp(_lhs._limbs, _lhs._size, _rhs._limbs, _rhs._size) >= 0; }
+
+	private:
+		db::uint64_t* _limbs;
+		db::size_t _size;
+		db::size_t _cap;
+		db::uint64_t _small[inline_limbs];
+
+		void reserve(const db::size_t _new_cap)
+		{
+			if (_new_cap <= _cap) {
+				return;
+			}
+			const db::size_t cap = std::max(_new_cap, _cap * 2);
+			db::uint64_t* limbs = new db::uint64_t[cap];
+			db::memcpy(limbs, _limbs, _size);
+			if (_limbs != _small) {
+				delete[] _limbs;
+			}
+			_limbs = limbs;
+			_cap = cap;
+		}
+
+		// * grows with zeroed limbs or cuts down to _new_size
+		void resize(const db::size_t _new_size)
+		{
+			reserve(_new_size);
+			if (_new_size > _size) {
+				std::fill(_limbs + _size, _limbs + _new_size, 0ULL);
+			}
+			_size = _new_size;
+		}
+
+		void push_back(const db::uint64_t _limb)
+		{
+			reserve(_size + 1);
+			_limbs[_size++] = _limb;
+		}
+
+		void trim() noexcept
+		{
+			while (_size && _limbs[_size - 1] == 0) {
+				--_size;
+			}
+		}
+
+		void assign(const db::uint64_t* _src, const db::size_t _len)
+		{
+			_size = 0;
+			reserve(_len);
+			db::memcpy(_limbs, _src, _len);
+			_size = _len;
+		}
+
+		// * 64 x 64 -> 128 bit multiplication, mulx when BMI2 is available
+		static db::uint64_t mul_limb(const db::uint64_t _a, const db::uint64_t _b, db::uint64_t* _hi) noexcept
+		{
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+			return _mulx_u64(_a, _b, _hi);
+#elif defined(_MSC_VER)
+			return _umul128(_a, _b, _hi);
+#else
+			const unsigned __int128 res = static_cast<unsigned __int128>(_a) * _b;
+			*_hi = static_cast<db::uint64_t>(res >> 64);
+			return static_cast<db::uint64_t>(res);
+#endif
+		}
+
+		// * add with carry, adcx when ADX is available
+		static unsigned char add_carry(const unsigned char _carry, const db::uint64_t _a, const db::uint64_t _b, db::uint64_t* _out) noexcept
+		{
+#if defined(__ADX__) || (defined(_MSC_VER) && defined(__AVX2__))
+			return _addcarryx_u64(_carry, _a, _b, _out);
+#else
+			return _addcarry_u64(_carry, _a, _b, _out);
+#endif
+		}
+
+		static unsigned char sub_borrow(const unsigned char _borrow, const db::uint64_t _a, const db::uint64_t _b, db::uint64_t* _out) noexcept
+		{
+			return _subborrow_u64(_borrow, _a, _b, _out);
+		}
+
+		// * 128 / 64 bit division, _hi has to be smaller than _div
+		static db::uint64_t div_limb(const db::uint64_t _hi, const db::uint64_t _lo, const db::uint64_t _div, db::uint64_t* _rem) noexcept
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			return _udiv128(_hi, _lo, _div, _rem);
+#else
+			const unsigned __int128 num = (static_cast<unsigned __int128>(_hi) << 64) | _lo;
+			*_rem = static_cast<db::uint64_t>(num % _div);
+			return static_cast<db::uint64_t>(num / _div);
+#endif
+		}
+
+		static db::int32_t raw_cmp(const db::uint64_t* _a, const db::size_t _na, const db::uint64_t* _b, const db::size_t _nb) noexcept
+		{
+			if (_na != _nb) {
+				return _na < _nb ? -1 : 1;
+			}
+			for (db::size_t i = _na; i-- != 0;) {
+				if (_a[i] != _b[i]) {
+					return _a[i] < _b[i] ? -1 : 1;
+				}
+			}
+			return 0;
+		}
+
+		// * _dst[0, _nd) += _src[0, _ns), returns the carry out of _dst
+		static unsigned char raw_add_to(db::uint64_t* _dst, const db::size_t _nd, const db::uint64_t* _src, const db::size_t _ns) noexcept
+		{
+			unsigned char carry = 0;
+			db::size_t i = 0;
+			for (; i != _ns; ++i) {
+				carry = add_carry(carry, _dst[i], _src[i], &_dst[i]);
+			}
+			for (; carry && i != _nd; ++i) {
+				carry = add_carry(carry, _dst[i], 0, &_dst[i]);
+			}
+			return carry;
+		}
+
+		// * _dst[0, _nd) -= _src[0, _ns), returns the borrow out of _dst
+		static unsigned char raw_sub_from(db::uint64_t* _dst, const db::size_t _nd, const db::uint64_t* _src, const db::size_t _ns) noexcept
+		{
+			unsigned char borrow = 0;
+			db::size_t i = 0;
+			for (; i != _ns; ++i) {
+				borrow = sub_borrow(borrow, _dst[i], _src[i], &_dst[i]);
+			}
+			for (; borrow && i != _nd; ++i) {
+				borrow = sub_borrow(borrow, _dst[i], 0, &_dst[i]);
+			}
+			return borrow;
+		}
+
+		// * _dst[0, _len) += _src[0, _len) * _mul, returns the high limb
+		static db::uint64_t raw_mul_add_1(db::uint64_t* _dst, const db::uint64_t* _src, const db::size_t _len, const db::uint64_t _mul) noexcept
+		{
+			db::uint64_t carry = 0;
+			for (db::size_t i = 0; i != _len; ++i) {
+				db::uint64_t hi;
+				db::uint64_t lo = mul_limb(_src[i], _mul, &hi);
+				hi += add_carry(0, lo, carry, &lo);
+				hi += add_carry(0, _dst[i], lo, &_dst[i]);
+				carry = hi;
+			}
+			return carry;
+		}
+
+		// * _res[0, _na + _nb) = _a * _b
+		static void raw_mul_schoolbook(db::uint64_t* _res, const db::uint64_t* _a, const db::size_t _na, const db::uint64_t* _b, const db::size_t _nb) noexcept
+		{
+			std::fill(_res, _res + _na + _nb, 0ULL);
+			for (db::size_t i = 0; i != _nb; ++i) {
+				_res[i + _na] = raw_mul_add_1(_res + i, _a, _na, _b[i]);
+			}
+		}
+
+		// * _res[0, _na + _nb) = _a * _b, karatsuba above karatsuba_threshold
+		static void raw_mul(db::uint64_t* _res, const db::uint64_t* _a, db::size_t _na, const db::uint64_t* _b, db::size_t _nb)
+		{
+			if (_na < _nb) {
+				std::swap(_a, _b);
+				std::swap(_na, _nb);
+			}
+
+			if (_nb < karatsuba_threshold) {
+				raw_mul_schoolbook(_res, _a, _na, _b, _nb);
+				return;
+			}
+
+			const db::size_t half = (_na + 1) / 2;
+
+			// Unbalanced operands, multiply in _nb sized slices of _a
+			if (_nb <= half) {
+				std::vector<db::uint64_t> tmp(2 * _nb);
+				std::fill(_res, _res + _na + _nb, 0ULL);
+				for (db::size_t i = 0; i < _na; i += _nb) {
+					const db::size_t len = std::min(_nb, _na - i);
+					raw_mul(tmp.data(), _a + i, len, _b, _nb);
+					raw_add_to(_res + i, _na + _nb - i, tmp.data(), len + _nb);
+				}
+				return;
+			}
+
+			// a = a1 * B^half + a0, b = b1 * B^half + b0
+			const db::size_t high_a = _na - half;
+			const db::size_t high_b = _nb - half;
+			const db::size_t mid_len = 2 * half + 2;
+
+			std::vector<db::uint64_t> tmp(2 * (half + 1) + mid_len);
+			db::uint64_t* sum_a = tmp.data();
+			db::uint64_t* sum_b = sum_a + half + 1;
+			db::uint64_t* mid = sum_b + half + 1;
+
+			db::memcpy(sum_a, _a, half);
+			db::memcpy(sum_b, _b, half);
+			sum_a[half] = raw_add_to(sum_a, half, _a + half, high_a);
+			sum_b[half] = raw_add_to(sum_b, half, _b + half, high_b);
+
+			raw_mul(_res, _a, half, _b, half);                            // a0 * b0
+			raw_mul(_res + 2 * half, _a + half, high_a, _b + half, high_b); // a1 * b1
+			raw_mul(mid, sum_a, half + 1, sum_b, half + 1);
+
+			// (a0 + a1)(b0 + b1) - a0 * b0 - a1 * b1 = a0 * b1 + a1 * b0
+			raw_sub_from(mid, mid_len, _res, 2 * half);
+			raw_sub_from(mid, mid_len, _res + 2 * half, high_a + high_b);
+
+			const db::size_t upper = _na + _nb - half;
+			raw_add_to(_res + half, upper, mid, std::min(mid_len, upper));
+		}
+
+		// * _quot[0, _len) = _num / _div, returns the remainder
+		static db::uint64_t raw_divmod_1(db::uint64_t* _quot, const db::uint64_t* _num, const db::size_t _len, const db::uint64_t _div) noexcept
+		{
+			db::uint64_t rem = 0;
+			for (db::size_t i = _len; i-- != 0;) {
+				_quot[i] = div_limb(rem, _num[i], _div, &rem);
+			}
+			return rem;
+		}
+
+		// * Knuth algorithm D, _nd >= 2 and _nn >= _nd
+		static void raw_divmod(db::uint64_t* _quot, db::uint64_t* _rem, const db::uint64_t* _num, const db::size_t _nn, const db::uint64_t* _div, const db::size_t _nd)
+		{
+			const db::uint32_t shift = static_cast<db::uint32_t>(std::countl_zero(_div[_nd - 1]));
+
+			std::vector<db::uint64_t> tmp(_nn + 1 + _nd);
+			db::uint64_t* un = tmp.data();
+			db::uint64_t* vn = un + _nn + 1;
+
+			// Normalize so the top bit of the divisor is set
+			for (db::size_t i = _nd; i-- != 0;) {
+				vn[i] = (_div[i] << shift) | (shift && i ? _div[i - 1] >> (64U - shift) : 0);
+			}
+			un[_nn] = shift ? _num[_nn - 1] >> (64U - shift) : 0;
+			for (db::size_t i = _nn; i-- != 0;) {
+				un[i] = (_num[i] << shift) | (shift && i ? _num[i - 1] >> (64U - shift) : 0);
+			}
+
+			const db::uint64_t v_top = vn[_nd - 1];
+			const db::uint64_t v_next = vn[_nd - 2];
+
+			for (db::size_t j = _nn - _nd + 1; j-- != 0;) {
+				db::uint64_t qhat;
+				db::uint64_t rhat;
+				bool rhat_overflow = false;
+
+				if (un[j + _nd] >= v_top) {
+					qhat = ~0ULL;
+					rhat_overflow = add_carry(0, un[j + _nd - 1], v_top, &rhat);
+				}
+				else {
+					qhat = div_limb(un[j + _nd], un[j + _nd - 1], v_top, &rhat);
+				}
+
+				while (!rhat_overflow) {
+					db::uint64_t hi;
+					const db::uint64_t lo = mul_limb(qhat, v_next, &hi);
+					if (hi < rhat || (hi == rhat && lo <= un[j + _nd - 2])) {
+						break;
+					}
+					--qhat;
+					rhat_overflow = add_carry(0, rhat, v_top, &rhat);
+				}
+
+				// un[j, j + _nd] -= qhat * vn
+				db::uint64_t carry = 0;
+				unsigned char borrow = 0;
+				for (db::size_t i = 0; i != _nd; ++i) {
+					db::uint64_t hi;
+					db::uint64_t lo = mul_limb(qhat, vn[i], &hi);
+					hi += add_carry(0, lo, carry, &lo);
+					carry = hi;
+					borrow = sub_borrow(borrow, un[i + j], lo, &un[i + j]);
+				}
+				borrow = sub_borrow(borrow, un[j + _nd], carry, &un[j + _nd]);
+
+				// qhat was one too large, add back
+				if (borrow) {
+					--qhat;
+					un[j + _nd] += raw_add_to(un + j, _nd, vn, _nd);
+				}
+
+				_quot[j] = qhat;
+			}
+
+			for (db::size_t i = 0; i != _nd; ++i) {
+				_rem[i] = (un[i] >> shift) | (shift ? un[i + 1] << (64U - shift) : 0);
+			}
+		}
+	};
+}
+
+// NUMBER TO STRING
+namespace db
+{
+	// * Floatingpoint to string
+	template <db::size_t _PRECISION = 5, class char_type = char, class Ty = float>
+	constexpr inline std::basic_string<char_type> ftos(Ty _num)
+	{
+		DB_INSTRUMENT_SCOPE(ftos, 0);
+
+		char_type buff[21 + _PRECISION];
+		char_type* begin = buff;
+
+		// Negative check
+		if (_num < 0.0) {
+			*begin++ = '-';
+			_num *= -1.0;
+		}
+
+		// Round
+		static const auto prec1 = std::pow(0.1, _PRECISION);
+		const double tmp_num = _num / prec1;
+		_num = (tmp_num >= 0.5 ? (tmp_num + 1.0) : tmp_num) * prec1;
+
+		// Get first number
+		db::size_t first = static_cast<db::size_t>(_num);
+		_num -= first;
+		_num *= 10.0;
+
+		char_type* beg = begin;
+
+		// Set First
+		while (first >= 1) {
+			*begin++ = static_cast<char_type>(first % 10 + '0');
+			first /= 10;
+		}
+
+		std::reverse(beg, begin);
+
+		if (_num) {
+			*begin++ = '.';
+
+			db::size_t maxlen = _PRECISION;
+
+			while (_num && maxlen--)
+			{
+				first = static_cast<db::size_t>(_num);
+				_num -= first;
+				_num *= 10.0;
+				*begin++ = static_cast<char_type>(first + '0');
+			}
+		}
+
+		DB_INSTRUMENT_SIZE(begin - buff);
+		return std::basic_string<char_type>(buff, static_cast<db::size_t>(begin - buff));
+	}
+
+	// * Number to binary string
+	template <class char_type = char, class Ty = db::int32_t, bool FULL_OUTPUT = true>
+	constexpr inline std::basic_string<char_type> ntobs(const Ty _num) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(ntobs, std::numeric_limits<Ty>::digits);
+
+		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
+		constexpr auto buff_size = std::numeric_limits<Ty>::digits + can_negative;
+		constexpr auto buff_last = buff_size - 1;
+
+		char_type buff[buff_size];
+		char_type* begin = buff + buff_size;
+		const bool is_negative = _num < 0;
+
+		if (is_negative) {
+			*buff = '1';
+		}
+		else {
+			*buff = '0';
+		}
+
+		auto num = db::to_unsigned(_num);
+
+		if constexpr (FULL_OUTPUT) {
+			for (db::int32_t i = 0; i != buff_size - can_negative; ++i) {
+				*--begin = (num & 1) + '0';
+				num /= 2;
+			}
+		}
+		else {
+			while (num) {
+				*--begin = (num & 1) + '0';
+				num /= 2;
+			}
+
+		}
+
+		return std::basic_string<char_type>((FULL_OUTPUT == true ? buff : begin), (FULL_OUTPUT == true ? buff_size : (buff + buff_size) - begin));
+	}
+
+	// * Number to decimal string
+	template <class char_type = char, class Ty = db::int32_t>
+	constexpr inline std::basic_string<char_type> ntods(const Ty _num) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(ntods, 0);
+
+		constexpr static auto digits2 = [](const db::size_t _num) noexcept -> const char* const
+		{
+			return &"0001020304050607080910111213141516171819"
+				"2021222324252627282930313233343536373839"
+				"4041424344454647484950515253545556575859"
+				"6061626364656667686970717273747576777879"
+				"8081828384858687888990919293949596979899"[_num * 2];
+		};
+		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
+		constexpr auto buff_size = std::numeric_limits<Ty>::digits10 + can_negative + 2;
+		constexpr auto buff_last = buff_size - 1;
+
+		char_type buff[buff_size];
+		char_type* begin = buff + buff_last;
+		const bool is_negative = _num < 0;
+
+		auto num = db::to_unsigned(_num);
+		db::uint8_t tmp;
+
+		while (num >= 100) {
+			tmp = num % 100;
+			num /= 100;
+			std::memcpy(begin -= 2, digits2(tmp), 2);
+		}
+
+		if (num < 10) {
+			*--begin = static_cast<char_type>('0' + num);
+		}
+		else {
+			std::memcpy(begin -= 2, digits2(num), 2);
+			if (is_negative) {
+				*--begin = static_cast<char_type>('-');
+			}
+		}
+
+		DB_INSTRUMENT_SIZE((buff + buff_last) - begin);
+		return std::basic_string<char_type>(begin, (buff + buff_last) - begin);
+	}
+
+	// * Big number to decimal string
+	template <class char_type = char>
+	inline std::basic_string<char_type> ntods(const db::big_uint& _num)
+	{
+		DB_INSTRUMENT_SCOPE(ntods, 0);
+
+		constexpr db::uint64_t chunk_div = 10000000000000000000ULL; // 10^19
+		constexpr db::size_t chunk_digits = 19;
+
+		if (_num.is_zero()) {
+			return std::basic_string<char_type>(1, static_cast<char_type>('0'));
+		}
+
+		// Split into base 10^19 chunks, lowest first
+		db::big_uint num = _num;
+		std::vector<db::uint64_t> chunks;
+		chunks.reserve(_num.limbs() * 64U / 63U + 1);
+		while (!num.is_zero()) {
+			chunks.push_back(num.div_small(chunk_div));
+		}
+
+		// Highest chunk without leading zeros, the lower ones padded to 19 digits
+		db::size_t head_digits = 0;
+		for (db::uint64_t head = chunks.back(); head; head /= 10) {
+			++head_digits;
+		}
+
+		std::basic_string<char_type> res(head_digits + (chunks.size() - 1) * chunk_digits, static_cast<char_type>('0'));
+
+		char_type* end = res.data() + res.size();
+		for (db::size_t i = 0; i != chunks.size(); ++i) {
+			db::uint64_t chunk = chunks[i];
+			const db::size_t digits = i + 1 == chunks.size() ? head_digits : chunk_digits;
+			for (db::size_t d = 0; d != digits; ++d) {
+				*--end = static_cast<char_type>('0' + chunk % 10);
+				chunk /= 10;
+			}
+		}
+
+		DB_INSTRUMENT_SIZE(res.size());
+		return res;
+	}
+
+	// * Number to Hex string
+	template <class char_type = char, class Ty = db::int32_t>
+	constexpr inline std::basic_string<char_type> ntohs(const Ty _num) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(ntohs, 0);
+
+		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
+		constexpr auto buff_size = std::numeric_limits<Ty>::digits10 + can_negative;
+		constexpr auto buff_last = buff_size - 1;
+
+		char_type buff[buff_size];
+		char_type* begin = buff + buff_last;
+		const bool is_negative = _num < 0;
+
+		auto num = db::to_unsigned(_num);
+		db::uint8_t tmp;
+
+		while (num) {
+			tmp = num % 16;
+			if (tmp >= 10) {
+				*begin-- = static_cast<char_type>(tmp + 'A' - 10);
+			}
+			else {
+				*begin-- = static_cast<char_type>(tmp + '0');
+			}
+			num /= 16;
+		}
+
+		if (is_negative) {
+			*begin = static_cast<char_type>('-');
+		}
+		else {
+			++begin;
+		}
+
+		DB_INSTRUMENT_SIZE((buff + buff_size) - begin);
+		return std::basic_string<char_type>(begin, (buff + buff_size) - begin);
+	}
+}
+
+// STRING TO NUMBER
+namespace db
+{
+	// * Floatingpoint string to double
+	template <class char_type>
+	constexpr inline double fstod(const char_type* _str)
+	{
+		DB_INSTRUMENT_SCOPE(fstod, 0);
+
+		const bool is_negative = (*_str == '-' ? ++_str : false);
+		const db::size_t _len = db::strlen(_str);
+		DB_INSTRUMENT_SIZE(_len + is_negative);
+
+		bool has_point = false;
+		db::uint8_t current;
+		std::double_t num = 0.0;
+		db::size_t len = _len;
+
+		while (static_cast<db::uint32_t>(is_negative) != len--) {
+			current = _str[len];
+
+			if (current == '.') {
+				--len;
+				has_point = true;
+				break;
+			}
+			else {
+				num += (current - '0');
+				num /= 10;
+			}
+		}
+
+		if (has_point) {
+			db::size_t before = 0;
+
+			for (db::size_t i = 0; i != len; ++i) {
+				current = _str[i];
+				before += (current - '0');
+				before *= 10;
+			}
+
+			current = _str[len];
+			before += (current - '0');
+
+			num += before;
+		}
+		else {
+			num = static_cast<db::size_t>(num * std::pow(10, _len));
+		}
+
+		return num;
+	}
+
+	// * Binary string to number
+	template <class Ty = db::size_t, class char_type>
+	constexpr inline Ty bston(const char_type* const _str, const bool _big_endian = true)
+	{
+		DB_INSTRUMENT_SCOPE(bston, 0);
+
+		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
+		constexpr auto num_max = std::numeric_limits<Ty>::max();
+		const db::size_t _len = db::strlen(_str);
+		DB_INSTRUMENT_SIZE(_len);
+
+		const bool is_negative = (_big_endian == true ? (*_str == '1') : *(_str + _len) == '1');
+
+		Ty num = 0;
+		Ty tmp_num = 0;
+
+		for (db::size_t i = 0; i < _len; ++i)
+		{
+			if (_str[i] != '0' && _str[i] != '1') {
+				throw std::invalid_argument("Only binary strings");
+			}
+
+			if (_str[i] == '1') {
+				const db::size_t _expo = (_big_endian == true ? (_len - i - 1) : i);
+				if (_expo == 0) {
+					tmp_num += 1;
+				}
+				else {
+					tmp_num += static_cast<db::size_t>(2) << (_expo - 1);
+				}
+			}
+			else {
+				continue;
+			}
+
+			if (tmp_num < num) {
+				return num_max;
+			}
+
+			num = tmp_num;
+		}
+
+		if (can_negative) {
+			if (is_negative) {
+				num *= static_cast<Ty>(-1);
+			}
+		}
+
+		return num;
+	}
+
+	// * Decimal string to number
+	template <class Ty = db::size_t, class char_type>
+	constexpr inline Ty dston(const char_type* _str)
+	{
+		DB_INSTRUMENT_CURSOR(dston, _str);
+
+		if constexpr (std::is_same_v<Ty, db::big_uint>) {
+			if (*_str == '-') {
+				throw std::invalid_argument("only unsigned number strings");
+			}
+
+			// Collect up to 19 digits per multiply
+			db::big_uint num;
+			while (*_str)
+			{
+				db::uint64_t chunk = 0;
+				db::uint64_t scale = 1;
+				for (db::size_t i = 0; i != 19 && *_str; ++i, scale *= 10) {
+					if (*_str < '0' || *_str > '9') {
+						throw std::invalid_argument("only number strings");
+					}
+					chunk = (chunk * 10) + (*_str++ - '0');
+				}
+				num.mul_add(scale, chunk);
+			}
+
+			return num;
+		}
+		else {
+			constexpr auto can_negative = !std::is_unsigned_v<Ty>;
+			constexpr auto num_max = std::numeric_limits<Ty>::max();
+
+			const bool is_negative = (*_str == '-' ? ++_str : false);
+
+			Ty num = 0;
+			Ty tmp_num = 0;
+
+			while (*_str)
+			{
+				if (*_str < '0' || *_str > '9') {
+					throw std::invalid_argument("only number strings");
+				}
+
+				tmp_num = (num * 10) + (*_str++ - '0');
+
+				if (tmp_num < num) {
+					return num_max;
+				}
+
+				num = tmp_num;
+			}
+
+			if (is_negative) {
+				num *= static_cast<Ty>(-1);
+			}
+
+			return num;
+		}
+	}
+
+	// * Hex string to number
+	template <class Ty = db::size_t, class char_type>
+	constexpr inline Ty hston(const char_type* _str)
+	{
+		DB_INSTRUMENT_CURSOR(hston, _str);
+
+		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
+		constexpr auto num_max = std::numeric_limits<Ty>::max();
+
+		const bool is_negative = (*_str == '-' ? ++_str : false);
+
+		if (*_str == 'x' || *_str == 'X') {
+			_str += 2;
+		}
+
+		Ty num = 0;
+		Ty tmp_num = 0;
+
+		while (*_str)
+		{
+			tmp_num = num * 16;
+
+			if (*_str >= '0' && *_str <= '9') {
+				tmp_num += *_str++ - '0';
+			}
+			else if (*_str >= 'a' && *_str <= 'f') {
+				tmp_num += 10 + *_str++ - 'a';
+			}
+			else if (*_str >= 'A' && *_str <= 'F') {
+				tmp_num += 10 + *_str++ - 'A';
+			}
+			else {
+				throw std::invalid_argument("only hex number strings");
+			}
+
+			if (tmp_num < num) {
+				return num_max;
+			}
+
+			num = tmp_num;
+		}
+
+		if constexpr (can_negative) {
+			if (is_negative) {
+				num *= static_cast<Ty>(-1);
+			}
+		}
+
+		return num;
+	}
+
+	// * Number string to number
+	// Binary
+	// Decimal
+	// Hexadecimal
+	// - not 100% accurate
+	template <class Ty = db::size_t, class char_type>
+	constexpr inline Ty ston(const char_type* _str, const bool _big_endian_if_bin = true)
+	{
+		// the input length is recorded by the parser it forwards to
+		DB_INSTRUMENT_SCOPE(ston, 0);
+
+		switch(db::guess_base<char_type>(_str))
+		{
+		case 2:
+			return db::bston<Ty, char_type>(_str, _big_endian_if_bin);
+		case 10:
+			return db::dston<Ty, char_type>(_str);
+		case 16:
+			return db::hston<Ty, char_type>(_str);
+		default:
+			return 0;
+		}
+	}
+}
+
+// BASE64
+namespace db
+{
+	enum class base64 : db::uint8_t
+	{
+		standard, // + and /
+		url       // - and _
+	};
+
+	// * chars needed to encode _len bytes
+	constexpr inline db::size_t base64_encoded_size(const db::size_t _len, const bool _padding = true) noexcept
+	{
+		if (_padding) {
+			return (_len + 2) / 3 * 4;
+		}
+		return _len / 3 * 4 + (_len % 3 ? _len % 3 + 1 : 0);
+	}
+
+	// * exact bytes _src decodes to, padding is optional
+	template <class char_type>
+	constexpr inline db::size_t base64_decoded_size(const char_type* _src, db::size_t _len)
+	{
+		for (db::size_t i = 0; i != 2 && _len && _src[_len - 1] == '='; ++i) {
+			--_len;
+		}
+		if (_len % 4 == 1) {
+			throw std::invalid_argument("invalid base64 string");
+		}
+		return _len / 4 * 3 + (_len % 4 ? _len % 4 - 1 : 0);
+	}
+
+	// * 32 chars of any type narrowed to 32 bytes, chars above 255 become 0 or 255
+	template <class char_type>
+	inline __m256i load_chars_simd(const char_type* _src) noexcept
+	{
+		static_assert(sizeof(char_type) == 1 || sizeof(char_type) == 2 || sizeof(char_type) == 4, "unsupported char type");
+
+		const __m256i* src = reinterpret_cast<const __m256i*>(_src);
+		if constexpr (sizeof(char_type) == 1) {
+			return _mm256_loadu_si256(src);
+		}
+		else if constexpr (sizeof(char_type) == 2) {
+			const __m256i packed = _mm256_packus_epi16(_mm256_loadu_si256(src), _mm256_loadu_si256(src + 1));
+			return _mm256_permute4x64_epi64(packed, 0xD8);
+		}
+		else {
+			const __m256i ab = _mm256_packus_epi32(_mm256_loadu_si256(src), _mm256_loadu_si256(src + 1));
+			const __m256i cd = _mm256_packus_epi32(_mm256_loadu_si256(src + 2), _mm256_loadu_si256(src + 3));
+			return _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+		}
+	}
+
+	// * 32 bytes widened to 32 chars of any type
+	template <class char_type>
+	inline void store_chars_simd(char_type* _dst, const __m256i _bytes) noexcept
+	{
+		static_assert(sizeof(char_type) == 1 || sizeof(char_type) == 2 || sizeof(char_type) == 4, "unsupported char type");
+
+		__m256i* dst = reinterpret_cast<__m256i*>(_dst);
+		if constexpr (sizeof(char_type) == 1) {
+			_mm256_storeu_si256(dst, _bytes);
+		}
+		else if constexpr (sizeof(char_type) == 2) {
+			_mm256_storeu_si256(dst, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(_bytes)));
+			_mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(_bytes, 1)));
+		}
+		else {
+			const __m128i lo = _mm256_castsi256_si128(_bytes);
+			const __m128i hi = _mm256_extracti128_si256(_bytes, 1);
+			_mm256_storeu_si256(dst, _mm256_cvtepu8_epi32(lo));
+			_mm256_storeu_si256(dst + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+			_mm256_storeu_si256(dst + 2, _mm256_cvtepu8_epi32(hi));
+			_mm256_storeu_si256(dst + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+		}
+	}
+
+	// * the 64 chars of an alphabet
+	template <db::base64 Alphabet>
+	constexpr const char* base64_chars = Alphabet == db::base64::standard
+		? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+		: "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+	// * char to 6 bit value, 0xFF for chars outside the alphabet
+	template <db::base64 Alphabet>
+	constexpr std::array<db::uint8_t, 256> base64_values = [] {
+		std::array<db::uint8_t, 256> values{};
+		for (auto& value : values) {
+			value = 0xFF;
+		}
+		for (db::uint8_t i = 0; i != 64; ++i) {
+			values[static_cast<db::uint8_t>(db::base64_chars<Alphabet>[i])] = i;
+		}
+		return values;
+	}();
+
+	// * encodes _len bytes as base64, 24 bytes into 32 chars per step, needs AVX2
+	// _dst needs room for base64_encoded_size(_len, Padding) chars, returns the chars written
+	template <db::base64 Alphabet = db::base64::standard, bool Padding = true, class char_type = char>
+	inline db::size_t base64_encode(const db::uint8_t* _src, const db::size_t _len, char_type* _dst) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(base64_encode, _len);
+
+		// Offsets from 6 bit values to ascii, picked by value range
+		const __m256i lut = Alphabet == db::base64::standard
+			? _mm256_setr_epi8(
+				65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+				65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0)
+			: _mm256_setr_epi8(
+				65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -17, 32, 0, 0,
+				65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -17, 32, 0, 0);
+
+		const db::uint8_t* src = _src;
+		const db::uint8_t* const src_end = _src + _len;
+		char_type* dst = _dst;
+
+		// Reads 32 bytes but only uses 24
+		for (; src_end - src >= 32; src += 24, dst += 32) {
+			__m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+
+			// 12 bytes per 128 bit lane, each 3 byte group spread over 4 bytes
+			in = _mm256_permutevar8x32_epi32(in, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+			in = _mm256_shuffle_epi8(in, _mm256_set_epi8(
+				10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+				14, 15, 13, 14, 11, 12, 10, 11, 8, 9, 7, 8, 5, 6, 4, 5));
+
+			// Cut out the 6 bit values
+			const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+			const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+			const __m256i values = _mm256_or_si256(t0, t1);
+
+			// 0..25 -> index 0, 26..51 -> 1, 52..61 -> 2..11, 62 -> 12, 63 -> 13
+			__m256i indices = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+			indices = _mm256_sub_epi8(indices, _mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)));
+
+			db::store_chars_simd(dst, _mm256_add_epi8(values, _mm256_shuffle_epi8(lut, indices)));
+		}
+
+		// encode rest 3 bytes at a time
+		const char* chars = db::base64_chars<Alphabet>;
+		for (; src_end - src >= 3; src += 3) {
+			const db::uint32_t group = (static_cast<db::uint32_t>(src[0]) << 16) | (static_cast<db::uint32_t>(src[1]) << 8) | src[2];
+			*dst++ = static_cast<char_type>(chars[(group >> 18) & 0x3F]);
+			*dst++ = static_cast<char_type>(chars[(group >> 12) & 0x3F]);
+			*dst++ = static_cast<char_type>(chars[(group >> 6) & 0x3F]);
+			*dst++ = static_cast<char_type>(chars[group & 0x3F]);
+		}
+
+		if (src != src_end) {
+			const bool two = src_end - src == 2;
+			const db::uint32_t group = (static_cast<db::uint32_t>(src[0]) << 16) | (two ? static_cast<db::uint32_t>(src[1]) << 8 : 0);
+			*dst++ = static_cast<char_type>(chars[(group >> 18) & 0x3F]);
+			*dst++ = static_cast<char_type>(chars[(group >> 12) & 0x3F]);
+			if (two) {
+				*dst++ = static_cast<char_type>(chars[(group >> 6) & 0x3F]);
+			}
+			if constexpr (Padding) {
+				if (!two) {
+					*dst++ = static_cast<char_type>('=');
+				}
+				*dst++ = static_cast<char_type>('=');
+			}
+		}
+
+		return static_cast<db::size_t>(dst - _dst);
+	}
+
+	// * base64 encode into a new string
+	template <db::base64 Alphabet = db::base64::standard, bool Padding = true, class char_type = char>
+	inline std::basic_string<char_type> base64_encode(const db::uint8_t* _src, const db::size_t _len)
+	{
+		std::basic_string<char_type> res(db::base64_encoded_size(_len, Padding), char_type());
+		db::base64_encode<Alphabet, Padding>(_src, _len, res.data());
+		return res;
+	}
+
+	// * decodes _len base64 chars, 32 chars into 24 bytes per step, needs AVX2
+	// validates every block in register, _dst needs room for base64_decoded_size(_src, _len) bytes
+	// returns the bytes written, throws on chars outside the alphabet
+	template <db::base64 Alphabet = db::base64::standard, class char_type>
+	inline db::size_t base64_decode(const char_type* _src, db::size_t _len, db::uint8_t* _dst)
+	{
+		DB_INSTRUMENT_SCOPE(base64_decode, _len);
+
+		for (db::size_t i = 0; i != 2 && _len && _src[_len - 1] == '='; ++i) {
+			--_len;
+		}
+		if (_len % 4 == 1) {
+			throw std::invalid_argument("invalid base64 string");
+		}
+
+		constexpr bool standard = Alphabet == db::base64::standard;
+
+		// A char is valid when lut_lo[low nibble] & lut_hi[high nibble] == 0
+		const __m256i lut_lo = standard
+			? _mm256_setr_epi8(
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A)
+			: _mm256_setr_epi8(
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x3B, 0x3B, 0x3A, 0x3B, 0x1B,
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x3B, 0x3B, 0x3A, 0x3B, 0x1B);
+		const __m256i lut_hi = standard
+			? _mm256_setr_epi8(
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10)
+			: _mm256_setr_epi8(
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x20, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x20, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+
+		// Offsets from ascii to 6 bit values by high nibble, the one char sharing
+		// its nibble with letters ('/' or '_') gets patched separately
+		const __m256i lut_roll = standard
+			? _mm256_setr_epi8(
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0)
+			: _mm256_setr_epi8(
+				0, 0, 17, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 0, 17, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+
+		const char_type* src = _src;
+		const char_type* const src_end = _src + _len;
+		db::uint8_t* dst = _dst;
+
+		for (; src_end - src >= 32; src += 32, dst += 24) {
+			__m256i str = db::load_chars_simd(src);
+
+			const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), nibble_mask);
+			const __m256i lo_nibbles = _mm256_and_si256(str, nibble_mask);
+			if (!_mm256_testz_si256(_mm256_shuffle_epi8(lut_lo, lo_nibbles), _mm256_shuffle_epi8(lut_hi, hi_nibbles))) {
+				break; // the scalar loop below reports the bad char
+			}
+
+			__m256i roll;
+			if constexpr (standard) {
+				const __m256i is_slash = _mm256_cmpeq_epi8(str, _mm256_set1_epi8('/'));
+				roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(is_slash, hi_nibbles));
+			}
+			else {
+				const __m256i is_underscore = _mm256_cmpeq_epi8(str, _mm256_set1_epi8('_'));
+				roll = _mm256_blendv_epi8(_mm256_shuffle_epi8(lut_roll, hi_nibbles), _mm256_set1_epi8(-32), is_underscore);
+			}
+			str = _mm256_add_epi8(str, roll);
+
+			// Pack 4 x 6 bit into 3 bytes and squeeze out the gaps
+			str = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+			str = _mm256_madd_epi16(str, _mm256_set1_epi32(0x00011000));
+			str = _mm256_shuffle_epi8(str, _mm256_setr_epi8(
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+			str = _mm256_permutevar8x32_epi32(str, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+
+			// Exactly 24 bytes so _dst never overflows
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(str));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), _mm256_extracti128_si256(str, 1));
+		}
+
+		// decode rest 4 chars at a time
+		const auto value = [](const char_type _ch) -> db::uint32_t {
+			const auto ch = static_cast<std::make_unsigned_t<char_type>>(_ch);
+			const db::uint8_t res = ch > 0xFF ? 0xFF : db::base64_values<Alphabet>[ch];
+			if (res == 0xFF) {
+				throw std::invalid_argument("invalid base64 string");
+			}
+			return res;
+		};
+
+		for (; src_end - src >= 4; src += 4) {
+			const db::uint32_t group = (value(src[0]) << 18) | (value(src[1]) << 12) | (value(src[2]) << 6) | value(src[3]);
+			*dst++ = static_cast<db::uint8_t>(group >> 16);
+			*dst++ = static_cast<db::uint8_t>(group >> 8);
+			*dst++ = static_cast<db::uint8_t>(group);
+		}
+
+		if (src != src_end) {
+			const bool three = src_end - src == 3;
+			const db::uint32_t group = (value(src[0]) << 18) | (value(src[1]) << 12) | (three ? value(src[2]) << 6 : 0);
+			*dst++ = static_cast<db::uint8_t>(group >> 16);
+			if (three) {
+				*dst++ = static_cast<db::uint8_t>(group >> 8);
+			}
+		}
+
+		return static_cast<db::size_t>(dst - _dst);
+	}
+
+	// * base64 decode into a new buffer
+	template <db::base64 Alphabet = db::base64::standard, class char_type>
+	inline std::vector<db::uint8_t> base64_decode(const char_type* _src, const db::size_t _len)
+	{
+		std::vector<db::uint8_t> res(db::base64_decoded_size(_src, _len));
+		db::base64_decode<Alphabet>(_src, _len, res.data());
+		return res;
+	}
+}
+
+// CHECKSUM
+namespace db
+{
+	constexpr db::uint32_t crc32c_poly = 0x82F63B78U; // castagnoli, reflected
+	constexpr db::uint32_t crc32_poly = 0xEDB88320U;  // ieee, reflected
+	constexpr db::uint32_t adler32_base = 65521U;
+
+	// * crc32c_parallel stays single threaded below this length
+	constexpr db::size_t crc32c_parallel_min = 1ULL << 20;
+
+	// * _a * _b mod Poly for reflected crc polynomials
+	template <db::uint32_t Poly>
+	constexpr inline db::uint32_t crc_multmodp(db::uint32_t _a, db::uint32_t _b) noexcept
+	{
+		db::uint32_t res = 0;
+		for (db::uint32_t m = 1U << 31; m; m >>= 1) {
+			if (_a & m) {
+				res ^= _b;
+			}
+			_b = (_b & 1) ? (_b >> 1) ^ Poly : _b >> 1;
+		}
+		return res;
+	}
+
+	// * x^_n mod Poly for reflected crc polynomials
+	template <db::uint32_t Poly>
+	constexpr inline db::uint32_t crc_xpow(db::uint64_t _n) noexcept
+	{
+		db::uint32_t res = 1U << 31; // x^0
+		db::uint32_t base = 1U << 30; // x^1
+		for (; _n; _n >>= 1) {
+			if (_n & 1) {
+				res = db::crc_multmodp<Poly>(base, res);
+			}
+			base = db::crc_multmodp<Poly>(base, base);
+		}
+		return res;
+	}
+
+	// * crc of A + B from crc(A), crc(B) and the length of B
+	template <db::uint32_t Poly>
+	constexpr inline db::uint32_t crc_combine(const db::uint32_t _crc1, const db::uint32_t _crc2, const db::size_t _len2) noexcept
+	{
+		return db::crc_multmodp<Poly>(db::crc_xpow<Poly>(static_cast<db::uint64_t>(_len2) * 8), _crc1) ^ _crc2;
+	}
+
+	constexpr inline db::uint32_t crc32c_combine(const db::uint32_t _crc1, const db::uint32_t _crc2, const db::size_t _len2) noexcept
+	{
+		return db::crc_combine<db::crc32c_poly>(_crc1, _crc2, _len2);
+	}
+
+	constexpr inline db::uint32_t crc32_combine(const db::uint32_t _crc1, const db::uint32_t _crc2, const db::size_t _len2) noexcept
+	{
+		return db::crc_combine<db::crc32_poly>(_crc1, _crc2, _len2);
+	}
+
+	// * byte wise lookup table of a reflected crc polynomial
+	template <db::uint32_t Poly>
+	constexpr std::array<db::uint32_t, 256> crc_table = [] {
+		std::array<db::uint32_t, 256> table{};
+		for (db::uint32_t i = 0; i != 256; ++i) {
+			db::uint32_t crc = i;
+			for (db::uint32_t bit = 0; bit != 8; ++bit) {
+				crc = (crc & 1) ? (crc >> 1) ^ Poly : crc >> 1;
+			}
+			table[i] = crc;
+		}
+		return table;
+	}();
+
+	// * crc32c (castagnoli) of _len bytes, needs SSE4.2 and PCLMUL
+	// three independent streams hide the 3 cycle latency, clmul shifts merge them
+	// pass the previous result as _crc to continue a stream
+	inline db::uint32_t crc32c(const void* _data, db::size_t _len, const db::uint32_t _crc = 0) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(crc32c, _len);
+
+		const db::uint8_t* data = static_cast<const db::uint8_t*>(_data);
+		db::uint64_t crc0 = static_cast<db::uint32_t>(~_crc);
+
+		// crc * x^(8 * len) through clmul, the constant is x^(8 * len - 33)
+		const auto shift = [](const db::uint64_t _value, const db::uint32_t _k) noexcept {
+			const __m128i prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(_value)), _mm_cvtsi32_si128(static_cast<int>(_k)), 0x00);
+			return static_cast<db::uint64_t>(_mm_crc32_u64(0, static_cast<db::uint64_t>(_mm_cvtsi128_si64(prod))));
+		};
+
+		const auto interleave = [&]<db::size_t Block>() noexcept {
+			constexpr db::uint32_t k1 = db::crc_xpow<db::crc32c_poly>(Block * 8 - 33);
+			constexpr db::uint32_t k2 = db::crc_xpow<db::crc32c_poly>(Block * 16 - 33);
+
+			for (; _len >= Block * 3; _len -= Block * 3, data += Block * 3) {
+				db::uint64_t crc1 = 0;
+				db::uint64_t crc2 = 0;
+				for (db::size_t i = 0; i != Block; i += 8) {
+					db::uint64_t in0;
+					db::uint64_t in1;
+					db::uint64_t in2;
+					std::memcpy(&in0, data + i, 8);
+					std::memcpy(&in1, data + Block + i, 8);
+					std::memcpy(&in2, data + Block * 2 + i, 8);
+					crc0 = _mm_crc32_u64(crc0, in0);
+					crc1 = _mm_crc32_u64(crc1, in1);
+					crc2 = _mm_crc32_u64(crc2, in2);
+				}
+				crc0 = shift(crc0, k2) ^ shift(crc1, k1) ^ crc2;
+			}
+		};
+
+		interleave.template operator()<4096>();
+		interleave.template operator()<256>();
+
+		// rest 8 bytes at a time
+		for (; _len >= 8; _len -= 8, data += 8) {
+			db::uint64_t in;
+			std::memcpy(&in, data, 8);
+			crc0 = _mm_crc32_u64(crc0, in);
+		}
+
+		db::uint32_t crc = static_cast<db::uint32_t>(crc0);
+		for (; _len; --_len) {
+			crc = _mm_crc32_u8(crc, *data++);
+		}
+
+		return ~crc;
+	}
+
+	// * crc32 (ieee, zlib) of _len bytes, needs PCLMUL and SSE4.1
+	// folds 4 x 128 bit per step and barrett reduces at the end
+	// pass the previous result as _crc to continue a stream
+	inline db::uint32_t crc32(const void* _data, db::size_t _len, const db::uint32_t _crc = 0) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(crc32, _len);
+
+		const db::uint8_t* data = static_cast<const db::uint8_t*>(_data);
+		db::uint32_t crc = ~_crc;
+
+		if (_len >= 64) {
+			const auto load = [](const db::uint8_t* _ptr) noexcept {
+				return _mm_loadu_si128(reinterpret_cast<const __m128i*>(_ptr));
+			};
+			const auto fold = [](const __m128i _acc, const __m128i _k, const __m128i _next) noexcept {
+				const __m128i lo = _mm_clmulepi64_si128(_acc, _k, 0x00);
+				const __m128i hi = _mm_clmulepi64_si128(_acc, _k, 0x11);
+				return _mm_xor_si128(_mm_xor_si128(lo, hi), _next);
+			};
+
+			// x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32), x^64 mod P and the barrett constants
+			const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL);
+			const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL);
+			const __m128i k5 = _mm_set_epi64x(0, 0x0163CD6124LL);
+			const __m128i poly = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL);
+			const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+			__m128i x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+			__m128i x2 = load(data + 16);
+			__m128i x3 = load(data + 32);
+			__m128i x4 = load(data + 48);
+			data += 64;
+			_len -= 64;
+
+			for (; _len >= 64; data += 64, _len -= 64) {
+				x1 = fold(x1, k1k2, load(data));
+				x2 = fold(x2, k1k2, load(data + 16));
+				x3 = fold(x3, k1k2, load(data + 32));
+				x4 = fold(x4, k1k2, load(data + 48));
+			}
+
+			x1 = fold(x1, k3k4, x2);
+			x1 = fold(x1, k3k4, x3);
+			x1 = fold(x1, k3k4, x4);
+
+			for (; _len >= 16; data += 16, _len -= 16) {
+				x1 = fold(x1, k3k4, load(data));
+			}
+
+			// 128 -> 64 bit
+			x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+			x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+			x2 = _mm_srli_si128(x1, 4);
+			x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5, 0x00), x2);
+
+			// barrett 64 -> 32 bit
+			x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x10);
+			x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), poly, 0x00);
+			crc = static_cast<db::uint32_t>(_mm_extract_epi32(_mm_xor_si128(x1, x2), 1));
+		}
+
+		// rest one by one
+		for (; _len; --_len) {
+			crc = db::crc_table<db::crc32_poly>[(crc ^ *data++) & 0xFFU] ^ (crc >> 8);
+		}
+
+		return ~crc;
+	}
+
+	// * adler32 (zlib) of _len bytes, starts at 1, needs AVX2
+	// pass the previous result as _adler to continue a stream
+	inline db::uint32_t adler32(const void* _data, db::size_t _len, const db::uint32_t _adler = 1) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(adler32, _len);
+
+		constexpr db::size_t nmax = 5552; // most bytes before the sums can overflow 32 bit
+
+		const db::uint8_t* data = static_cast<const db::uint8_t*>(_data);
+		db::uint32_t a = _adler & 0xFFFFU;
+		db::uint32_t b = _adler >> 16;
+
+		const __m256i weights = _mm256_setr_epi8(
+			32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+			16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+		const __m256i ones = _mm256_set1_epi16(1);
+
+		const auto hsum = [](const __m256i _v) noexcept {
+			const __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(_v), _mm256_extracti128_si256(_v, 1));
+			const __m128i sum2 = _mm_add_epi32(sum, _mm_unpackhi_epi64(sum, sum));
+			return static_cast<db::uint32_t>(_mm_cvtsi128_si32(_mm_add_epi32(sum2, _mm_shuffle_epi32(sum2, 0x01))));
+		};
+
+		while (_len >= 32) {
+			db::size_t block = std::min(_len, nmax) & ~static_cast<db::size_t>(31);
+			_len -= block;
+
+			__m256i vs1 = _mm256_setr_epi32(static_cast<int>(a), 0, 0, 0, 0, 0, 0, 0);
+			__m256i vs2 = _mm256_setr_epi32(static_cast<int>(b), 0, 0, 0, 0, 0, 0, 0);
+			__m256i vs1_sum = _mm256_setzero_si256(); // a before every 32 byte step, each adds 32 * a to b
+
+			for (; block; block -= 32, data += 32) {
+				const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+				vs1_sum = _mm256_add_epi32(vs1_sum, vs1);
+				vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+				vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, weights), ones));
+			}
+
+			vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(vs1_sum, 5));
+			a = hsum(vs1) % db::adler32_base;
+			b = hsum(vs2) % db::adler32_base;
+		}
+
+		// rest one by one
+		for (; _len; --_len) {
+			a += *data++;
+			b += a;
+		}
+
+		return ((b % db::adler32_base) << 16) | (a % db::adler32_base);
+	}
+
+	// * adler32 of A + B from adler32(A), adler32(B) and the length of B
+	constexpr inline db::uint32_t adler32_combine(const db::uint32_t _adler1, const db::uint32_t _adler2, const db::size_t _len2) noexcept
+	{
+		constexpr db::uint32_t base = db::adler32_base;
+		const db::uint32_t rem = static_cast<db::uint32_t>(_len2 % base);
+
+		db::uint32_t sum1 = _adler1 & 0xFFFFU;
+		db::uint32_t sum2 = (rem * sum1) % base;
+		sum1 += (_adler2 & 0xFFFFU) + base - 1;
+		sum2 += (_adler1 >> 16) + (_adler2 >> 16) + base - rem;
+
+		if (sum1 >= base) {
+			sum1 -= base;
+		}
+		if (sum1 >= base) {
+			sum1 -= base;
+		}
+		if (sum2 >= base * 2) {
+			sum2 -= base * 2;
+		}
+		if (sum2 >= base) {
+			sum2 -= base;
+		}
+
+		return sum1 | (sum2 << 16);
+	}
+
+	// * crc32c of a big buffer over _threads threads, chunks are merged with crc32c_combine
+	// 0 threads means hardware_concurrency
+	inline db::uint32_t crc32c_parallel(const void* _data, const db::size_t _len, const db::uint32_t _crc = 0, db::uint32_t _threads = 0)
+	{
+		if (_threads == 0) {
+			_threads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		if (_len < db::crc32c_parallel_min || _threads < 2) {
+			return db::crc32c(_data, _len, _crc);
+		}
+
+		const db::uint8_t* data = static_cast<const db::uint8_t*>(_data);
+		const db::size_t chunk = (_len + _threads - 1) / _threads;
+		std::vector<db::uint32_t> crcs(_threads);
+		std::vector<std::thread> workers;
+		workers.reserve(_threads);
+
+		for (db::uint32_t t = 0; t != _threads; ++t) {
+			workers.emplace_back([&, t] {
+				const db::size_t begin = std::min(_len, t * chunk);
+				crcs[t] = db::crc32c(data + begin, std::min(_len, begin + chunk) - begin);
+			});
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+
+		db::uint32_t crc = _crc;
+		for (db::uint32_t t = 0; t != _threads; ++t) {
+			const db::size_t begin = std::min(_len, t * chunk);
+			crc = db::crc32c_combine(crc, crcs[t], std::min(_len, begin + chunk) - begin);
+		}
+		return crc;
+	}
+}
+
+// INTEGER CODECS
+namespace db
+{
+	// * zigzag maps small negative and positive numbers to small unsigned numbers
+	// 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...
+	template <class Ty>
+	constexpr inline std::make_unsigned_t<Ty> zigzag_encode(const Ty _num) noexcept
+	{
+		static_assert(std::is_integral_v<Ty>, "zigzag needs an integer type");
+
+		using uint_type = std::make_unsigned_t<Ty>;
+		return static_cast<uint_type>((static_cast<uint_type>(db::to_unsigned(_num)) << 1) - (_num < 0));
+	}
+
+	template <class Ty>
+	constexpr inline std::make_signed_t<Ty> zigzag_decode(const Ty _num) noexcept
+	{
+		static_assert(std::is_unsigned_v<Ty>, "zigzag decode needs an unsigned type");
+
+		return static_cast<std::make_signed_t<Ty>>((_num >> 1) ^ (static_cast<Ty>(0) - (_num & 1)));
+	}
+
+	template <class Ty>
+	constexpr inline void zigzag_encode(const Ty* _src, const db::size_t _len, std::make_unsigned_t<Ty>* _dst) noexcept
+	{
+		for (db::size_t i = 0; i != _len; ++i) {
+			_dst[i] = db::zigzag_encode(_src[i]);
+		}
+	}
+
+	template <class Ty>
+	constexpr inline void zigzag_decode(const Ty* _src, const db::size_t _len, std::make_signed_t<Ty>* _dst) noexcept
+	{
+		for (db::size_t i = 0; i != _len; ++i) {
+			_dst[i] = db::zigzag_decode(_src[i]);
+		}
+	}
+
+	// * _dst[i] = _src[i] - _src[i - 1], the first number is stored relative to _prev
+	// works in place, signed deltas should go through zigzag_encode after this
+	template <class Ty>
+	inline void delta_encode(const Ty* _src, const db::size_t _len, Ty* _dst, const Ty _prev = 0) noexcept
+	{
+		static_assert(std::is_unsigned_v<Ty>, "delta coding needs an unsigned type");
+
+		if (_len == 0) {
+			return;
+		}
+
+		// back to front so _dst may be _src
+		db::size_t i = _len;
+		if constexpr (sizeof(Ty) == 4) {
+			for (; i >= 9; i -= 8) {
+				const __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_src + i - 8));
+				const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_src + i - 9));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(_dst + i - 8), _mm256_sub_epi32(cur, prev));
+			}
+		}
+		for (; i > 1; --i) {
+			_dst[i - 1] = static_cast<Ty>(_src[i - 1] - _src[i - 2]);
+		}
+		_dst[0] = static_cast<Ty>(_src[0] - _prev);
+	}
+
+	// * prefix sum, undoes delta_encode, works in place
+	template <class Ty>
+	inline void delta_decode(const Ty* _src, const db::size_t _len, Ty* _dst, Ty _prev = 0) noexcept
+	{
+		static_assert(std::is_unsigned_v<Ty>, "delta coding needs an unsigned type");
+
+		db::size_t i = 0;
+		if constexpr (sizeof(Ty) == 4) {
+			__m256i prev = _mm256_set1_epi32(static_cast<int>(_prev));
+			for (; i + 8 <= _len; i += 8) {
+				__m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_src + i));
+				sum = _mm256_add_epi32(sum, _mm256_slli_si256(sum, 4));
+				sum = _mm256_add_epi32(sum, _mm256_slli_si256(sum, 8));
+				// carry the last sum of the low lane into the high lane
+				const __m256i low_last = _mm256_shuffle_epi32(sum, 0xFF);
+				sum = _mm256_add_epi32(sum, _mm256_permute2x128_si256(low_last, low_last, 0x08));
+				sum = _mm256_add_epi32(sum, prev);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(_dst + i), sum);
+				prev = _mm256_permutevar8x32_epi32(sum, _mm256_set1_epi32(7));
+			}
+			_prev = static_cast<Ty>(_mm256_cvtsi256_si32(prev));
+		}
+		for (; i != _len; ++i) {
+			_prev = static_cast<Ty>(_prev + _src[i]);
+			_dst[i] = _prev;
+		}
+	}
+
+	// * most bytes one number takes as leb128 varint
+	template <class Ty>
+	constexpr db::size_t varint_max_bytes = (sizeof(Ty) * 8 + 6) / 7;
+
+	// * output buffer size that always fits _len varints
+	template <class Ty>
+	constexpr inline db::size_t varint_max_size(const db::size_t _len) noexcept
+	{
+		return _len * db::varint_max_bytes<Ty>;
+	}
+
+	// * leb128 varint, 7 bits per byte, high bit set on all but the last byte
+	// returns the bytes written
+	template <class Ty>
+	inline db::size_t varint_encode(const Ty* _src, const db::size_t _len, db::uint8_t* _dst) noexcept
+	{
+		static_assert(std::is_unsigned_v<Ty>, "varint needs an unsigned type, use zigzag_encode for signed numbers");
+
+		DB_INSTRUMENT_SCOPE(varint_encode, _len);
+
+		db::uint8_t* dst = _dst;
+		for (db::size_t i = 0; i != _len; ++i) {
+			Ty num = _src[i];
+			while (num >= 0x80) {
+				*dst++ = static_cast<db::uint8_t>(num | 0x80);
+				num >>= 7;
+			}
+			*dst++ = static_cast<db::uint8_t>(num);
+		}
+		return static_cast<db::size_t>(dst - _dst);
+	}
+
+	// * decodes _len varints from _size bytes, returns the bytes read
+	// numbers up to 8 bytes are read with one load and pext, throws on truncated or too long input
+	template <class Ty>
+	inline db::size_t varint_decode(const db::uint8_t* _src, const db::size_t _size, Ty* _dst, const db::size_t _len)
+	{
+		static_assert(std::is_unsigned_v<Ty>, "varint needs an unsigned type, use zigzag_decode for signed numbers");
+
+		DB_INSTRUMENT_SCOPE(varint_decode, _len);
+
+		constexpr db::uint32_t bits = sizeof(Ty) * 8;
+		const db::uint8_t* src = _src;
+		const db::uint8_t* const end = _src + _size;
+
+		for (db::size_t i = 0; i != _len; ++i) {
+			if (end - src >= 8) {
+				db::uint64_t word;
+				std::memcpy(&word, src, 8);
+				const db::uint64_t stops = ~word & 0x8080808080808080ULL;
+				if (stops) {
+					const db::uint32_t bytes = (static_cast<db::uint32_t>(std::countr_zero(stops)) >> 3) + 1;
+					if (bytes > db::varint_max_bytes<Ty>) {
+						throw std::invalid_argument("varint too long");
+					}
+					const db::uint64_t keep = bytes == 8 ? ~0ULL : (1ULL << (bytes * 8)) - 1;
+					const db::uint64_t num = _pext_u64(word & keep, 0x7F7F7F7F7F7F7F7FULL);
+					if constexpr (bits < 56) {
+						if (num >> bits) {
+							throw std::invalid_argument("varint too long");
+						}
+					}
+					_dst[i] = static_cast<Ty>(num);
+					src += bytes;
+					continue;
+				}
+			}
+
+			// byte by byte near the end and for numbers above 8 bytes
+			db::uint64_t num = 0;
+			for (db::uint32_t shift = 0;; shift += 7) {
+				if (src == end) {
+					throw std::invalid_argument("varint truncated");
+				}
+				if (shift >= bits) {
+					throw std::invalid_argument("varint too long");
+				}
+				const db::uint64_t byte = *src++;
+				if (shift + 7 > bits && (byte & 0x7F) >> (bits - shift)) {
+					throw std::invalid_argument("varint too long");
+				}
+				num |= (byte & 0x7F) << shift;
+				if (!(byte & 0x80)) {
+					break;
+				}
+			}
+			_dst[i] = static_cast<Ty>(num);
+		}
+		return static_cast<db::size_t>(src - _src);
+	}
+
+	// * output buffer size that always fits _len stream-vbyte numbers
+	constexpr inline db::size_t streamvbyte_max_size(const db::size_t _len) noexcept
+	{
+		return (_len + 3) / 4 + _len * 4;
+	}
+
+	// * pshufb masks and data lengths for every control byte
+	constexpr auto streamvbyte_tables = [] {
+		struct tables_t {
+			db::uint8_t shuffle[256][16];
+			db::uint8_t length[256];
+		} tables{};
+
+		for (db::uint32_t ctrl = 0; ctrl != 256; ++ctrl) {
+			db::uint8_t offset = 0;
+			for (db::uint32_t k = 0; k != 4; ++k) {
+				const db::uint32_t bytes = ((ctrl >> (k * 2)) & 3) + 1;
+				for (db::uint32_t b = 0; b != 4; ++b) {
+					tables.shuffle[ctrl][k * 4 + b] = b < bytes ? static_cast<db::uint8_t>(offset + b) : 0x80;
+				}
+				offset = static_cast<db::uint8_t>(offset + bytes);
+			}
+			tables.length[ctrl] = offset;
+		}
+		return tables;
+	}();
+
+	// * stream-vbyte, 2 bit lengths of 4 numbers per control byte, all controls first then the data bytes
+	// returns the bytes written
+	inline db::size_t streamvbyte_encode(const db::uint32_t* _src, const db::size_t _len, db::uint8_t* _dst) noexcept
+	{
+		DB_INSTRUMENT_SCOPE(streamvbyte_encode, _len);
+
+		db::uint8_t* ctrl = _dst;
+		db::uint8_t* data = _dst + (_len + 3) / 4;
+		std::fill_n(ctrl, (_len + 3) / 4, static_cast<db::uint8_t>(0));
+
+		for (db::size_t i = 0; i != _len; ++i) {
+			const db::uint32_t num = _src[i];
+			const db::uint32_t code = (num > 0xFFU) + (num > 0xFFFFU) + (num > 0xFFFFFFU);
+			ctrl[i / 4] = static_cast<db::uint8_t>(ctrl[i / 4] | (code << (i % 4 * 2)));
+			// max_size always has room for a whole 4 byte store
+			std::memcpy(data, &num, 4);
+			data += code + 1;
+		}
+		return static_cast<db::size_t>(data - _dst);
+	}
+
+	// * decodes _len numbers from _size bytes with one pshufb per 4 numbers, returns the bytes read
+	// throws on truncated input
+	inline db::size_t streamvbyte_decode(const db::uint8_t* _src, const db::size_t _size, db::uint32_t* _dst, const db::size_t _len)
+	{
+		DB_INSTRUMENT_SCOPE(streamvbyte_decode, _len);
+
+		const db::size_t ctrl_len = (_len + 3) / 4;
+		if (_size < ctrl_len) {
+			throw std::invalid_argument("stream-vbyte truncated");
+		}
+
+		const db::uint8_t* ctrl = _src;
+		const db::uint8_t* data = _src + ctrl_len;
+		const db::uint8_t* const end = _src + _size;
+
+		db::size_t i = 0;
+		for (; i + 4 <= _len && end - data >= 16; i += 4) {
+			const db::uint8_t code = *ctrl++;
+			const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(db::streamvbyte_tables.shuffle[code]));
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(_dst + i), _mm_shuffle_epi8(bytes, mask));
+			data += db::streamvbyte_tables.length[code];
+		}
+
+		// last numbers byte by byte
+		for (; i != _len; ++i) {
+			const db::uint32_t bytes = ((_src[i / 4] >> (i % 4 * 2)) & 3) + 1;
+			if (static_cast<db::size_t>(end - data) < bytes) {
+				throw std::invalid_argument("stream-vbyte truncated");
+			}
+			db::uint32_t num = 0;
+			std::memcpy(&num, data, bytes);
+			_dst[i] = num;
+			data += bytes;
+		}
+		if (data > end) {
+			throw std::invalid_argument("stream-vbyte truncated");
+		}
+		return static_cast<db::size_t>(data - _src);
+	}
+
+	// * bits needed to bit pack every number of _src
+	template <class Ty>
+	inline db::uint32_t bitpack_width(const Ty* _src, const db::size_t _len) noexcept
+	{
+		static_assert(std::is_unsigned_v<Ty>, "bit packing needs an unsigned type");
+
+		Ty all = 0;
+		for (db::size_t i = 0; i != _len; ++i) {
+			all |= _src[i];
+		}
+		return static_cast<db::uint32_t>(std::bit_width(all));
+	}
+
+	// * bytes _len numbers take with _bits bits each
+	constexpr inline db::size_t bitpack_size(const db::size_t _len, const db::uint32_t _bits) noexcept
+	{
+		return (_len * _bits + 7) / 8;
+	}
+
+	// * packs _len numbers into _bits bits each, low bits first, higher bits are cut off
+	// returns the bytes written
+	template <class Ty>
+	inline db::size_t bitpack_encode(const Ty* _src, const db::size_t _len, const db::uint32_t _bits, db::uint8_t* _dst) noexcept
+	{
+		static_assert(std::is_unsigned_v<Ty>, "bit packing needs an unsigned type");
+
+		DB_INSTRUMENT_SCOPE(bitpack_encode, _len);
+
+		if (_bits == 0) {
+			return 0;
+		}
+
+		const db::uint64_t mask = _bits >= 64 ? ~0ULL : (1ULL << _bits) - 1;
+		db::uint8_t* dst = _dst;
+		db::uint64_t acc = 0;
+		db::uint32_t fill = 0;
+
+		for (db::size_t i = 0; i != _len; ++i) {
+			const db::uint64_t num = static_cast<db::uint64_t>(_src[i]) & mask;
+			acc |= num << fill;
+			if (fill + _bits >= 64) {
+				std::memcpy(dst, &acc, 8);
+				dst += 8;
+				acc = fill ? num >> (64 - fill) : 0;
+				fill = fill + _bits - 64;
+			}
+			else {
+				fill += _bits;
+			}
+		}
+
+		for (; fill > 0; fill = fill > 8 ? fill - 8 : 0, acc >>= 8) {
+			*dst++ = static_cast<db::uint8_t>(acc);
+		}
+		return static_cast<db::size_t>(dst - _dst);
+	}
+
+	// * unpacks _len numbers of _bits bits each, 4 byte numbers up to 25 bits use a gather per 8 numbers
+	template <class Ty>
+	inline void bitpack_decode(const db::uint8_t* _src, const db::size_t _len, const db::uint32_t _bits, Ty* _dst) noexcept
+	{
+		static_assert(std::is_unsigned_v<Ty>, "bit packing needs an unsigned type");
+
+		DB_INSTRUMENT_SCOPE(bitpack_decode, _len);
+
+		if (_bits == 0) {
+			std::fill_n(_dst, _len, static_cast<Ty>(0));
+			return;
+		}
+
+		const db::size_t size = db::bitpack_size(_len, _bits);
+		const db::uint64_t mask = _bits >= 64 ? ~0ULL : (1ULL << _bits) - 1;
+		db::size_t i = 0;
+
+		if constexpr (sizeof(Ty) == 4) {
+			if (_bits <= 25) {
+				// 8 numbers always take _bits whole bytes
+				const __m256i lane_bits = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(_bits)));
+				const __m256i index = _mm256_srli_epi32(lane_bits, 3);
+				const __m256i shift = _mm256_and_si256(lane_bits, _mm256_set1_epi32(7));
+				const __m256i vmask = _mm256_set1_epi32(static_cast<int>(mask));
+				const db::size_t last_read = (_bits * 7 >> 3) + 4;
+
+				for (const db::uint8_t* src = _src; i + 8 <= _len && static_cast<db::size_t>(src - _src) + last_read <= size; i += 8, src += _bits) {
+					const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src), index, 1);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(_dst + i), _mm256_and_si256(_mm256_srlv_epi32(words, shift), vmask));
+				}
+			}
+		}
+
+		for (; i != _len; ++i) {
+			const db::size_t offset = i * _bits;
+			const db::size_t byte = offset >> 3;
+			const db::uint32_t shift = offset & 7;
+
+			db::uint64_t word = 0;
+			std::memcpy(&word, _src + byte, std::min<db::size_t>(8, size - byte));
+			db::uint64_t num = word >> shift;
+			if (shift + _bits > 64) {
+				num |= static_cast<db::uint64_t>(_src[byte + 8]) << (64 - shift);
+			}
+			_dst[i] = static_cast<Ty>(num & mask);
+		}
+	}
+}
+
+// SORT
+namespace db
+{
+	// * arrays up to this length skip the radix passes
+	constexpr db::size_t small_sort_max = 64;
+
+	// * db::radix_sort_parallel stays single threaded below this length
+	constexpr db::size_t radix_sort_parallel_min = 1ULL << 24;
+
+	// * unsigned integer with the same size as Ty
+	template <class Ty>
+	using radix_key_t = typename db::enable_if_else<sizeof(Ty) == 1, db::uint8_t,
+		typename db::enable_if_else<sizeof(Ty) == 2, db::uint16_t,
+		typename db::enable_if_else<sizeof(Ty) == 4, db::uint32_t,
+		db::uint64_t>::type>::type>::type;
+
+	// * maps a number to an unsigned key with the same order
+	template <class Ty>
+	constexpr inline db::radix_key_t<Ty> radix_key(const Ty _num) noexcept
+	{
+		static_assert(std::is_arithmetic_v<Ty> && !std::is_same_v<Ty, bool>, "radix keys need integer or floating point types");
+
+		using key_type = db::radix_key_t<Ty>;
+		constexpr key_type sign = static_cast<key_type>(key_type(1) << (sizeof(Ty) * 8 - 1));
+
+		if constexpr (std::is_floating_point_v<Ty>) {
+			const key_type bits = std::bit_cast<key_type>(_num);
+			return (bits & sign) ? static_cast<key_type>(~bits) : static_cast<key_type>(bits | sign);
+		}
+		else if constexpr (std::is_signed_v<Ty>) {
+			return static_cast<key_type>(static_cast<key_type>(_num) ^ sign);
+		}
+		else {
+			return static_cast<key_type>(_num);
+		}
+	}
+
+	// * inverse of db::radix_key
+	template <class Ty>
+	constexpr inline Ty radix_unkey(const db::radix_key_t<Ty> _key) noexcept
+	{
+		using key_type = db::radix_key_t<Ty>;
+		constexpr key_type sign = static_cast<key_type>(key_type(1) << (sizeof(Ty) * 8 - 1));
+
+		if constexpr (std::is_floating_point_v<Ty>) {
+			return std::bit_cast<Ty>((_key & sign) ? static_cast<key_type>(_key ^ sign) : static_cast<key_type>(~_key));
+		}
+		else if constexpr (std::is_signed_v<Ty>) {
+			return static_cast<Ty>(static_cast<key_type>(_key ^ sign));
+		}
+		else {
+			return static_cast<Ty>(_key);
+		}
+	}
+
+	// * stable insertion sort by radix key, values move along when given
+	template <class Ty, class Value = void>
+	inline void insertion_sort(Ty* _data, const db::size_t _len, Value* _values = nullptr) noexcept
+	{
+		for (db::size_t i = 1; i < _len; ++i) {
+			const Ty cur = _data[i];
+			const auto cur_key = db::radix_key(cur);
+			db::size_t j = i;
+
+			if constexpr (std::is_void_v<Value>) {
+				for (; j && db::radix_key(_data[j - 1]) > cur_key; --j) {
+					_data[j] = _data[j - 1];
+				}
+				_data[j] = cur;
+			}
+			else {
+				Value cur_value = std::move(_values[i]);
+				for (; j && db::radix_key(_data[j - 1]) > cur_key; --j) {
+					_data[j] = _data[j - 1];
+					_values[j] = std::move(_values[j - 1]);
+				}
+				_data[j] = cur;
+				_values[j] = std::move(cur_value);
+			}
+		}
+	}
+
+	// * sorts up to small_sort_max 4 byte numbers with an in-register bitonic network, needs AVX2
+	// sorts the radix keys padded to a power of two, steps below 8 lanes shuffle inside one register
+	template <class Ty>
+	inline void bitonic_sort_simd(Ty* _data, const db::size_t _len) noexcept
+	{
+		static_assert(sizeof(Ty) == 4, "bitonic_sort_simd sorts 4 byte numbers");
+
+		if (_len < 2) {
+			return;
+		}
+
+		alignas(32) db::uint32_t keys[db::small_sort_max];
+		const db::size_t len = std::min(_len, db::small_sort_max);
+		const db::size_t padded = std::max<db::size_t>(8, std::bit_ceil(len));
+
+		for (db::size_t i = 0; i != len; ++i) {
+			keys[i] = db::radix_key(_data[i]);
+		}
+		std::fill(keys + len, keys + padded, 0xFFFFFFFFU);
+
+		const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+		for (db::size_t k = 2; k <= padded; k <<= 1) {
+			for (db::size_t j = k >> 1; j != 0; j >>= 1) {
+				if (j >= 8) {
+					// Whole registers against each other
+					for (db::size_t base = 0; base != padded; base += 8) {
+						if (base & j) {
+							continue;
+						}
+						__m256i* lo_ptr = reinterpret_cast<__m256i*>(keys + base);
+						__m256i* hi_ptr = reinterpret_cast<__m256i*>(keys + base + j);
+						const __m256i a = _mm256_load_si256(lo_ptr);
+						const __m256i b = _mm256_load_si256(hi_ptr);
+						const __m256i lo = _mm256_min_epu32(a, b);
+						const __m256i hi = _mm256_max_epu32(a, b);
+						const bool descending = (base & k) != 0;
+						_mm256_store_si256(lo_ptr, descending ? hi : lo);
+						_mm256_store_si256(hi_ptr, descending ? lo : hi);
+					}
+				}
+				else {
+					// Lane i pairs with lane i ^ j and keeps the max when it is the upper one of an ascending pair
+					const __m256i partner = _mm256_xor_si256(lanes, _mm256_set1_epi32(static_cast<int>(j)));
+					const __m256i upper = _mm256_cmpeq_epi32(_mm256_and_si256(lanes, _mm256_set1_epi32(static_cast<int>(j))), _mm256_set1_epi32(static_cast<int>(j)));
+
+					for (db::size_t base = 0; base != padded; base += 8) {
+						__m256i* ptr = reinterpret_cast<__m256i*>(keys + base);
+						const __m256i v = _mm256_load_si256(ptr);
+						const __m256i p = _mm256_permutevar8x32_epi32(v, partner);
+						const __m256i global = _mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(base)));
+						const __m256i descending = _mm256_cmpeq_epi32(_mm256_and_si256(global, _mm256_set1_epi32(static_cast<int>(k))), _mm256_set1_epi32(static_cast<int>(k)));
+						const __m256i take_max = _mm256_xor_si256(upper, descending);
+						_mm256_store_si256(ptr, _mm256_blendv_epi8(_mm256_min_epu32(v, p), _mm256_max_epu32(v, p), take_max));
+					}
+				}
+			}
+		}
+
+		for (db::size_t i = 0; i != len; ++i) {
+			_data[i] = db::radix_unkey<Ty>(keys[i]);
+		}
+	}
+
+	// * lsd radix passes over the lowest _bytes bytes of the key, 8 bit per pass
+	// values move along when given, returns true when the result ended up in the tmp buffers
+	template <class Ty, class Value = void>
+	inline bool raw_radix_sort_lsd(Ty* _data, Ty* _tmp, const db::size_t _len, const db::size_t _bytes, Value* _values = nullptr, Value* _tmp_values = nullptr) noexcept
+	{
+		db::size_t hist[sizeof(Ty)][256]{};
+
+		for (db::size_t i = 0; i != _len; ++i) {
+			const auto key = db::radix_key(_data[i]);
+			for (db::size_t b = 0; b != _bytes; ++b) {
+				++hist[b][(key >> (b * 8)) & 0xFFU];
+			}
+		}
+
+		Ty* src = _data;
+		Ty* dst = _tmp;
+		Value* src_values = _values;
+		Value* dst_values = _tmp_values;
+		bool in_tmp = false;
+
+		for (db::size_t b = 0; b != _bytes; ++b) {
+			const db::uint32_t shift = static_cast<db::uint32_t>(b * 8);
+
+			// Every key has the same digit, nothing to move
+			if (hist[b][(db::radix_key(src[0]) >> shift) & 0xFFU] == _len) {
+				continue;
+			}
+
+			db::size_t offsets[256];
+			for (db::size_t d = 0, sum = 0; d != 256; ++d) {
+				offsets[d] = sum;
+				sum += hist[b][d];
+			}
+
+			for (db::size_t i = 0; i != _len; ++i) {
+				const db::size_t pos = offsets[(db::radix_key(src[i]) >> shift) & 0xFFU]++;
+				dst[pos] = src[i];
+				if constexpr (!std::is_void_v<Value>) {
+					dst_values[pos] = std::move(src_values[i]);
+				}
+			}
+
+			std::swap(src, dst);
+			std::swap(src_values, dst_values);
+			in_tmp = !in_tmp;
+		}
+
+		return in_tmp;
+	}
+
+	// * sort for up to small_sort_max numbers, needs no scratch buffer
+	template <class Ty>
+	inline void small_sort(Ty* _data, const db::size_t _len) noexcept
 	{
-		const auto val = _mm_log2_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		if constexpr (sizeof(Ty) == 4) {
+			db::bitonic_sort_simd(_data, _len);
+		}
+		else {
+			db::insertion_sort(_data, _len);
+		}
 	}
 
-	// * log10 using simd instruction
-	inline double log10_simd(const double _val) noexcept
+	// * radix sort for integer and floating point numbers, _scratch needs room for _len numbers
+	template <class Ty>
+	inline void radix_sort(Ty* _data, const db::size_t _len, Ty* _scratch) noexcept
 	{
-		const auto val = _mm_log10_pd(_mm_set_sd(_val));
-		return _mm_cvtsd_f64(val);
+		DB_INSTRUMENT_SCOPE(radix_sort, _len);
+
+		if (_len <= db::small_sort_max) {
+			db::small_sort(_data, _len);
+			return;
+		}
+
+		if (db::raw_radix_sort_lsd(_data, _scratch, _len, sizeof(Ty))) {
+			db::memcpy(_data, _scratch, _len);
+		}
 	}
 
-	template<class Base, class Expo>
-	constexpr inline auto pow(Base _base, Expo _expo)
+	// * radix sort for integer and floating point numbers
+	template <class Ty>
+	inline void radix_sort(Ty* _data, const db::size_t _len)
 	{
-		using result = db::enable_if_else <std::is_integral_v<Base>,
-			typename db::enable_if_else<std::is_unsigned_v<Base>,
-			db::uint64_t,
-			db::int64_t>::type,
-			Base
-		>::type;
+		if (_len <= db::small_sort_max) {
+			DB_INSTRUMENT_SCOPE(radix_sort, _len);
+			db::small_sort(_data, _len);
+			return;
+		}
+		std::vector<Ty> scratch(_len);
+		db::radix_sort(_data, _len, scratch.data());
+	}
 
-		result res = 1;
+	// * stable radix sort of _keys, _values are reordered the same way
+	template <class Key, class Value>
+	inline void radix_sort(Key* _keys, Value* _values, const db::size_t _len)
+	{
+		DB_INSTRUMENT_SCOPE(radix_sort, _len);
 
-		while (_expo > 0) {
-			if (_expo & 1) {
-				res *= _base;
-			}
-			_base *= _base;
-			_expo >>= 1;
+		if (_len <= db::small_sort_max) {
+			db::insertion_sort(_keys, _len, _values);
+			return;
 		}
 
-		return res;
+		std::vector<Key> scratch(_len);
+		std::vector<Value> scratch_values(_len);
+		if (db::raw_radix_sort_lsd(_keys, scratch.data(), _len, sizeof(Key), _values, scratch_values.data())) {
+			std::move(scratch.begin(), scratch.end(), _keys);
+			std::move(scratch_values.begin(), scratch_values.end(), _values);
+		}
 	}
 
-	template<class Base, class Expo, class Mod>
-	constexpr inline auto powm(Base _base, Expo _expo, const Mod& _mod)
+	// * radix sort that splits big arrays on the top byte (msd) over _threads threads
+	// every bucket is then lsd sorted on its own, 0 threads means hardware_concurrency
+	template <class Ty>
+	inline void radix_sort_parallel(Ty* _data, const db::size_t _len, db::uint32_t _threads = 0)
 	{
-		using result = db::enable_if_else <std::is_integral_v<Base>,
-			typename db::enable_if_else<std::is_unsigned_v<Base>,
-			db::uint64_t,
-			db::int64_t>::type,
-			Base
-		>::type;
+		if (_threads == 0) {
+			_threads = std::max(1U, std::thread::hardware_concurrency());
+		}
+		if (_len < db::radix_sort_parallel_min || _threads < 2) {
+			db::radix_sort(_data, _len);
+			return;
+		}
 
-		result res = 1;
+		DB_INSTRUMENT_SCOPE(radix_sort, _len);
 
-		while (_expo > 0) {
-			if (_expo & 1) {
-				res = (res * _base) % _mod;
+		constexpr db::uint32_t top_shift = (sizeof(Ty) - 1) * 8;
+		const db::size_t chunk = (_len + _threads - 1) / _threads;
+
+		std::vector<Ty> scratch(_len);
+		std::vector<std::array<db::size_t, 256>> offsets(_threads);
+		std::array<db::size_t, 257> bucket_begin{};
+
+		const auto run = [_threads](auto&& _fn) {
+			std::vector<std::thread> workers;
+			workers.reserve(_threads);
+			for (db::uint32_t t = 0; t != _threads; ++t) {
+				workers.emplace_back(_fn, t);
+			}
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		};
+
+		// Top byte histogram per thread
+		run([&](const db::uint32_t _t) {
+			auto& hist = offsets[_t];
+			hist.fill(0);
+			const db::size_t end = std::min(_len, (_t + 1) * chunk);
+			for (db::size_t i = _t * chunk; i < end; ++i) {
+				++hist[db::radix_key(_data[i]) >> top_shift];
+			}
+		});
+
+		// Turn counts into write positions, thread order keeps it stable
+		for (db::size_t d = 0, sum = 0; d != 256; ++d) {
+			bucket_begin[d] = sum;
+			for (db::uint32_t t = 0; t != _threads; ++t) {
+				const db::size_t count = offsets[t][d];
+				offsets[t][d] = sum;
+				sum += count;
 			}
-			_base = (_base * _base) % _mod;
-			_expo >>= 1;
 		}
+		bucket_begin[256] = _len;
 
-		return res;
+		run([&](const db::uint32_t _t) {
+			auto& pos = offsets[_t];
+			const db::size_t end = std::min(_len, (_t + 1) * chunk);
+			for (db::size_t i = _t * chunk; i < end; ++i) {
+				scratch[pos[db::radix_key(_data[i]) >> top_shift]++] = _data[i];
+			}
+		});
+
+		// Buckets are independent now, the input serves as tmp buffer
+		std::atomic<db::size_t> next_bucket{ 0 };
+		run([&](const db::uint32_t) {
+			for (db::size_t d; (d = next_bucket.fetch_add(1, std::memory_order_relaxed)) < 256;) {
+				const db::size_t begin = bucket_begin[d];
+				const db::size_t len = bucket_begin[d + 1] - begin;
+				Ty* bucket = scratch.data() + begin;
+
+				if (len <= db::small_sort_max) {
+					db::small_sort(bucket, len);
+				}
+				else if (db::raw_radix_sort_lsd(bucket, _data + begin, len, sizeof(Ty) - 1)) {
+					continue;
+				}
+				db::memcpy(_data + begin, bucket, len);
+			}
+		});
 	}
 }
 
-// NUMBER TO STRING
+// SEARCH
 namespace db
 {
-	// * Floatingpoint to string
-	template <db::size_t _PRECISION = 5, class char_type = char, class Ty = float>
-	constexpr inline std::basic_string<char_type> ftos(Ty _num)
+	// * Binary search
+	template<class fIter, class Ty, class Fn>
+	constexpr inline fIter binary_search(fIter _first, fIter _last, const Ty& _what, Fn&& _cmp_func)
 	{
-		char_type buff[21 + _PRECISION];
-		char_type* begin = buff;
+		fIter iter;
+		std::ptrdiff_t count = std::distance(_first, _last);
+		db::size_t step;
 
-		// Negative check
-		if (_num < 0.0) {
-			*begin++ = '-';
-			_num *= -1.0;
+		DB_INSTRUMENT_SCOPE(binary_search, count);
+
+		while (count > 0LL) {
+			step = count / 2ULL;
+			iter = _first;
+			std::advance(iter, step);
+
+			if (_cmp_func(*iter, _what)) {
+				_first = ++iter;
+				count -= step + 1ULL;
+			}
+			else {
+				count = step;
+			}
 		}
 
-		// Round
-		static const auto prec1 = std::pow(0.1, _PRECISION);
-		const double tmp_num = _num / prec1;
-		_num = (tmp_num >= 0.5 ? (tmp_num + 1.0) : tmp_num) * prec1;
+		return _first;
+	}
 
-		// Get first number
-		db::size_t first = static_cast<db::size_t>(_num);
-		_num -= first;
-		_num *= 10.0;
+	// * Binary search
+	template<class fIter, class Ty, class Fn>
+	constexpr inline fIter binary_search(fIter _first, fIter _last, Ty&& _what, Fn&& _cmp_func)
+	{
+		return db::binary_search<fIter, std::remove_reference_t<Ty>>(_first, _last, std::as_const(_what), std::move(_cmp_func));
+	}
 
-		char_type* beg = begin;
+	// * Binary search ( std::less )
+	template<class fIter, class Ty>
+	constexpr inline fIter binary_search(fIter _first, fIter _last, const Ty& _what)
+	{
+		return db::binary_search<fIter, Ty>(_first, _last, _what, std::move(std::less<>{}));
+	}
 
-		// Set First
-		while (first >= 1) {
-			*begin++ = static_cast<char_type>(first % 10 + '0');
-			first /= 10;
-		}
+	// * Binary search ( std::less )
+	template<class fIter, class Ty>
+	constexpr inline fIter binary_search(fIter _first, fIter _last, Ty&& _what)
+	{
+		return db::binary_search<fIter, std::remove_reference_t<Ty>>(_first, _last, std::as_const(_what), std::move(std::less<>{}));
+	}
 
-		std::reverse(beg, begin);
+	// * sorted set operations gallop instead of block compare when one list is this many times longer
+	constexpr db::size_t gallop_min_ratio = 32;
 
-		if (_num) {
-			*begin++ = '.';
+	// * lower bound of _what in [_first, _last) for a _what expected close to _first
+	// exponential steps find the range, db::binary_search finishes it
+	template <class Ty>
+	inline const Ty* gallop_search(const Ty* _first, const Ty* const _last, const Ty& _what)
+	{
+		db::size_t len = static_cast<db::size_t>(_last - _first);
+		db::size_t step = 1;
+		db::size_t lo = 0;
 
-			db::size_t maxlen = _PRECISION;
+		while (step < len && _first[step] < _what) {
+			lo = step;
+			step *= 2;
+		}
+		return db::binary_search(_first + lo, _first + std::min(len, step + 1), _what);
+	}
 
-			while (_num && maxlen--)
-			{
-				first = static_cast<db::size_t>(_num);
-				_num -= first;
-				_num *= 10.0;
-				*begin++ = static_cast<char_type>(first + '0');
+	// * permutevar8x32 indices moving the set lanes of a mask to the front
+	// 4 byte lanes use all 256 masks, 8 byte lanes the first 16 masks as pairs of 4 byte lanes
+	template <db::size_t Size>
+	constexpr auto compress_table = [] {
+		std::array<db::uint64_t, Size == 4 ? 256 : 16> table{};
+		constexpr db::uint32_t lanes = Size == 4 ? 8 : 4;
+		for (db::uint32_t mask = 0; mask != table.size(); ++mask) {
+			db::uint32_t out = 0;
+			for (db::uint32_t lane = 0; lane != lanes; ++lane) {
+				if (mask & (1U << lane)) {
+					if constexpr (Size == 4) {
+						table[mask] |= static_cast<db::uint64_t>(lane) << (out++ * 8);
+					}
+					else {
+						table[mask] |= static_cast<db::uint64_t>(lane * 2 | (lane * 2 + 1) << 8) << (out++ * 16);
+					}
+				}
 			}
 		}
+		return table;
+	}();
 
-		return std::basic_string<char_type>(buff, static_cast<db::size_t>(begin - buff));
-	}
-
-	// * Number to binary string
-	template <class char_type = char, class Ty = db::int32_t, bool FULL_OUTPUT = true>
-	constexpr inline std::basic_string<char_type> ntobs(const Ty _num) noexcept
+	// * block compare helpers for 4 and 8 byte sorted set operations
+	template <class Ty>
+	struct set_simd
 	{
-		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
-		constexpr auto buff_size = std::numeric_limits<Ty>::digits + can_negative;
-		constexpr auto buff_last = buff_size - 1;
+		static_assert(std::is_integral_v<Ty> && (sizeof(Ty) == 4 || sizeof(Ty) == 8), "sorted set operations need 4 or 8 byte integers");
 
-		char_type buff[buff_size];
-		char_type* begin = buff + buff_size;
-		const bool is_negative = _num < 0;
+		static constexpr db::size_t lanes = 32 / sizeof(Ty);
 
-		if (is_negative) {
-			*buff = '1';
-		}
-		else {
-			*buff = '0';
+		static inline __m256i load(const Ty* _src) noexcept
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_src));
 		}
 
-		auto num = db::to_unsigned(_num);
-
-		if constexpr (FULL_OUTPUT) {
-			for (db::int32_t i = 0; i != buff_size - can_negative; ++i) {
-				*--begin = (num & 1) + '0';
-				num /= 2;
+		// bit per lane of _a that equals any lane of _b, compares all rotations of _b
+		static inline db::uint32_t match(const __m256i _a, __m256i _b) noexcept
+		{
+			if constexpr (sizeof(Ty) == 4) {
+				const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+				__m256i eq = _mm256_cmpeq_epi32(_a, _b);
+				for (db::size_t i = 1; i != lanes; ++i) {
+					_b = _mm256_permutevar8x32_epi32(_b, rotate);
+					eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(_a, _b));
+				}
+				return static_cast<db::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
 			}
-		}
-		else {
-			while (num) {
-				*--begin = (num & 1) + '0';
-				num /= 2;
+			else {
+				__m256i eq = _mm256_cmpeq_epi64(_a, _b);
+				for (db::size_t i = 1; i != lanes; ++i) {
+					_b = _mm256_permute4x64_epi64(_b, 0x39);
+					eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(_a, _b));
+				}
+				return static_cast<db::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
 			}
-
 		}
 
-		return std::basic_string<char_type>((FULL_OUTPUT == true ? buff : begin), (FULL_OUTPUT == true ? buff_size : (buff + buff_size) - begin));
-	}
-
-	// * Number to decimal string
-	template <class char_type = char, class Ty = db::int32_t>
-	constexpr inline std::basic_string<char_type> ntods(const Ty _num) noexcept
-	{
-		constexpr static auto digits2 = [](const db::size_t _num) noexcept -> const char* const
+		// writes the lanes of _a set in _mask to _dst, exactly popcount(_mask) numbers
+		static inline db::size_t compress_store(Ty* _dst, const __m256i _a, const db::uint32_t _mask) noexcept
 		{
-			return &"0001020304050607080910111213141516171819"
-				"2021222324252627282930313233343536373839"
-				"4041424344454647484950515253545556575859"
-				"6061626364656667686970717273747576777879"
-				"8081828384858687888990919293949596979899"[_num * 2];
-		};
-		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
-		constexpr auto buff_size = std::numeric_limits<Ty>::digits10 + can_negative + 2;
-		constexpr auto buff_last = buff_size - 1;
-
-		char_type buff[buff_size];
-		char_type* begin = buff + buff_last;
-		const bool is_negative = _num < 0;
-
-		auto num = db::to_unsigned(_num);
-		db::uint8_t tmp;
+			const db::uint32_t count = static_cast<db::uint32_t>(std::popcount(_mask));
+			const __m256i index = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(db::compress_table<sizeof(Ty)>[_mask])));
+			const __m256i packed = _mm256_permutevar8x32_epi32(_a, index);
 
-		while (num >= 100) {
-			tmp = num % 100;
-			num /= 100;
-			std::memcpy(begin -= 2, digits2(tmp), 2);
+			if constexpr (sizeof(Ty) == 4) {
+				const __m256i keep = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+				_mm256_maskstore_epi32(reinterpret_cast<int*>(_dst), keep, packed);
+			}
+			else {
+				const __m256i keep = _mm256_cmpgt_epi64(_mm256_set1_epi64x(count), _mm256_setr_epi64x(0, 1, 2, 3));
+				_mm256_maskstore_epi64(reinterpret_cast<long long*>(_dst), keep, packed);
+			}
+			return count;
 		}
+	};
 
-		if (num < 10) {
-			*--begin = static_cast<char_type>('0' + num);
-		}
-		else {
-			std::memcpy(begin -= 2, digits2(num), 2);
-			if (is_negative) {
-				*--begin = static_cast<char_type>('-');
+	// * intersection by galloping through _large once per number of _small, _dst may be _small
+	template <class Ty>
+	inline db::size_t raw_intersect_gallop(const Ty* _small, const db::size_t _small_len, const Ty* _large, const db::size_t _large_len, Ty* _dst)
+	{
+		const Ty* const large_end = _large + _large_len;
+		db::size_t count = 0;
+
+		for (db::size_t i = 0; i != _small_len && _large != large_end; ++i) {
+			const Ty what = _small[i];
+			_large = db::gallop_search(_large, large_end, what);
+			if (_large != large_end && *_large == what) {
+				_dst[count++] = what;
 			}
 		}
-
-		return std::basic_string<char_type>(begin, (buff + buff_last) - begin);
+		return count;
 	}
 
-	// * Number to Hex string
-	template <class char_type = char, class Ty = db::int32_t>
-	constexpr inline std::basic_string<char_type> ntohs(const Ty _num) noexcept
+	// * intersection of two sorted sets of similar size, all pairs of two blocks are compared at once
+	template <class Ty>
+	inline db::size_t raw_intersect_simd(const Ty* _a, const db::size_t _a_len, const Ty* _b, const db::size_t _b_len, Ty* _dst)
 	{
-		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
-		constexpr auto buff_size = std::numeric_limits<Ty>::digits10 + can_negative;
-		constexpr auto buff_last = buff_size - 1;
-
-		char_type buff[buff_size];
-		char_type* begin = buff + buff_last;
-		const bool is_negative = _num < 0;
-
-		auto num = db::to_unsigned(_num);
-		db::uint8_t tmp;
+		using simd = db::set_simd<Ty>;
+		constexpr db::size_t lanes = simd::lanes;
+
+		db::size_t i = 0;
+		db::size_t j = 0;
+		db::size_t count = 0;
+
+		if (i + lanes <= _a_len && j + lanes <= _b_len) {
+			__m256i a = simd::load(_a);
+			__m256i b = simd::load(_b);
+			for (;;) {
+				count += simd::compress_store(_dst + count, a, simd::match(a, b));
+
+				// a number of a matches one block of b at most, so matches are written once
+				const Ty a_max = _a[i + lanes - 1];
+				const Ty b_max = _b[j + lanes - 1];
+				if (a_max <= b_max) {
+					i += lanes;
+					if (i + lanes > _a_len) {
+						break;
+					}
+					a = simd::load(_a + i);
+				}
+				if (b_max <= a_max) {
+					j += lanes;
+					if (j + lanes > _b_len) {
+						break;
+					}
+					b = simd::load(_b + j);
+				}
+			}
+		}
 
-		while (num) {
-			tmp = num % 16;
-			if (tmp >= 10) {
-				*begin-- = static_cast<char_type>(tmp + 'A' - 10);
+		// rest merged, numbers of a block already matched are below _b[j] and get skipped
+		while (i != _a_len && j != _b_len) {
+			if (_a[i] < _b[j]) {
+				++i;
+			}
+			else if (_b[j] < _a[i]) {
+				++j;
 			}
 			else {
-				*begin-- = static_cast<char_type>(tmp + '0');
+				_dst[count++] = _a[i];
+				++i;
+				++j;
 			}
-			num /= 16;
 		}
+		return count;
+	}
+
+	// * numbers in both sorted sets, _dst needs room for the smaller set
+	// block compares with avx2 for similar sizes, gallops when one set is gallop_min_ratio times longer
+	template <class Ty>
+	inline db::size_t intersect(const Ty* _a, const db::size_t _a_len, const Ty* _b, const db::size_t _b_len, Ty* _dst)
+	{
+		DB_INSTRUMENT_SCOPE(intersect, _a_len + _b_len);
+
+		if (_a_len > _b_len) {
+			return db::intersect(_b, _b_len, _a, _a_len, _dst);
+		}
+		if (_a_len * db::gallop_min_ratio <= _b_len) {
+			return db::raw_intersect_gallop(_a, _a_len, _b, _b_len, _dst);
+		}
+		return db::raw_intersect_simd(_a, _a_len, _b, _b_len, _dst);
+	}
 
-		if (is_negative) {
-			*begin = static_cast<char_type>('-');
+	// * numbers in all _count sorted sets, _dst needs room for the smallest set
+	// intersects the two smallest sets first, then gallops the result through the others
+	template <class Ty>
+	inline db::size_t intersect(const Ty* const* _sets, const db::size_t* _lens, const db::size_t _count, Ty* _dst)
+	{
+		if (_count == 0) {
+			return 0;
 		}
-		else {
-			++begin;
+		if (_count == 1) {
+			std::copy_n(_sets[0], _lens[0], _dst);
+			return _lens[0];
 		}
 
-		return std::basic_string<char_type>(begin, (buff + buff_size) - begin);
+		std::vector<db::size_t> order(_count);
+		for (db::size_t i = 0; i != _count; ++i) {
+			order[i] = i;
+		}
+		std::sort(order.begin(), order.end(), [_lens](const db::size_t _l, const db::size_t _r) { return _lens[_l] < _lens[_r]; });
+
+		db::size_t len = db::intersect(_sets[order[0]], _lens[order[0]], _sets[order[1]], _lens[order[1]], _dst);
+		for (db::size_t i = 2; i != _count && len != 0; ++i) {
+			len = db::raw_intersect_gallop(_dst, len, _sets[order[i]], _lens[order[i]], _dst);
+		}
+		return len;
 	}
-}
 
-// STRING TO NUMBER
-namespace db
-{
-	// * Floatingpoint string to double
-	template <class char_type>
-	constexpr inline double fstod(const char_type* _str)
+	// * numbers in either sorted set, each once, _dst needs room for both sets
+	// merges branch free for similar sizes, gallops and copies whole runs of the longer set when skewed
+	template <class Ty>
+	inline db::size_t merge_union(const Ty* _a, const db::size_t _a_len, const Ty* _b, const db::size_t _b_len, Ty* _dst)
 	{
-		const bool is_negative = (*_str == '-' ? ++_str : false);
-		const db::size_t _len = db::strlen(_str);
-
-		bool has_point = false;
-		db::uint8_t current;
-		std::double_t num = 0.0;
-		db::size_t len = _len;
+		DB_INSTRUMENT_SCOPE(merge_union, _a_len + _b_len);
 
-		while (static_cast<db::uint32_t>(is_negative) != len--) {
-			current = _str[len];
+		if (_a_len > _b_len) {
+			return db::merge_union(_b, _b_len, _a, _a_len, _dst);
+		}
 
-			if (current == '.') {
-				--len;
-				has_point = true;
-				break;
+		const Ty* a = _a;
+		const Ty* b = _b;
+		const Ty* const a_end = _a + _a_len;
+		const Ty* const b_end = _b + _b_len;
+		Ty* dst = _dst;
+
+		if (_a_len * db::gallop_min_ratio <= _b_len) {
+			for (; a != a_end; ++a) {
+				const Ty* run_end = db::gallop_search(b, b_end, *a);
+				dst = std::copy(b, run_end, dst);
+				*dst++ = *a;
+				b = run_end != b_end && *run_end == *a ? run_end + 1 : run_end;
 			}
-			else {
-				num += (current - '0');
-				num /= 10;
+		}
+		else {
+			while (a != a_end && b != b_end) {
+				const Ty va = *a;
+				const Ty vb = *b;
+				*dst++ = va < vb ? va : vb;
+				a += !(vb < va);
+				b += !(va < vb);
 			}
+			dst = std::copy(a, a_end, dst);
 		}
+		return static_cast<db::size_t>(std::copy(b, b_end, dst) - _dst);
+	}
 
-		if (has_point) {
-			db::size_t before = 0;
+	// * numbers of sorted set _a that are not in sorted set _b, _dst needs room for _a
+	// block compares with avx2 for similar sizes, gallops when one set is gallop_min_ratio times longer
+	template <class Ty>
+	inline db::size_t difference(const Ty* _a, const db::size_t _a_len, const Ty* _b, const db::size_t _b_len, Ty* _dst)
+	{
+		DB_INSTRUMENT_SCOPE(difference, _a_len + _b_len);
 
-			for (db::size_t i = 0; i != len; ++i) {
-				current = _str[i];
-				before += (current - '0');
-				before *= 10;
-			}
+		using simd = db::set_simd<Ty>;
+		constexpr db::size_t lanes = simd::lanes;
 
-			current = _str[len];
-			before += (current - '0');
+		const Ty* const a_end = _a + _a_len;
+		const Ty* const b_end = _b + _b_len;
+		db::size_t count = 0;
 
-			num += before;
+		// few numbers of _a, look each up in _b
+		if (_a_len * db::gallop_min_ratio <= _b_len) {
+			for (const Ty* b = _b; _a != a_end; ++_a) {
+				b = db::gallop_search(b, b_end, *_a);
+				if (b == b_end || *b != *_a) {
+					_dst[count++] = *_a;
+				}
+			}
+			return count;
 		}
-		else {
-			num = static_cast<db::size_t>(num * std::pow(10, _len));
+
+		// few numbers of _b, copy the runs of _a between them
+		if (_b_len * db::gallop_min_ratio <= _a_len) {
+			const Ty* a = _a;
+			for (; _b != b_end && a != a_end; ++_b) {
+				const Ty* run_end = db::gallop_search(a, a_end, *_b);
+				count = static_cast<db::size_t>(std::copy(a, run_end, _dst + count) - _dst);
+				a = run_end != a_end && *run_end == *_b ? run_end + 1 : run_end;
+			}
+			return static_cast<db::size_t>(std::copy(a, a_end, _dst + count) - _dst);
 		}
 
-		return num;
+		db::size_t i = 0;
+		db::size_t j = 0;
+		db::uint32_t matched = 0; // lanes of the current block of _a found in _b so far
+
+		if (i + lanes <= _a_len && j + lanes <= _b_len) {
+			__m256i a = simd::load(_a);
+			__m256i b = simd::load(_b);
+			for (;;) {
+				matched |= simd::match(a, b);
+
+				const Ty a_max = _a[i + lanes - 1];
+				const Ty b_max = _b[j + lanes - 1];
+				if (a_max <= b_max) {
+					count += simd::compress_store(_dst + count, a, ~matched & ((1U << lanes) - 1));
+					matched = 0;
+					i += lanes;
+					if (i + lanes > _a_len) {
+						break;
+					}
+					a = simd::load(_a + i);
+				}
+				if (b_max <= a_max) {
+					j += lanes;
+					if (j + lanes > _b_len) {
+						break;
+					}
+					b = simd::load(_b + j);
+				}
+			}
+		}
+
+		// rest merged, matched still marks numbers of the current block found in earlier blocks of _b
+		for (db::size_t block = i; i != _a_len; ++i) {
+			while (j != _b_len && _b[j] < _a[i]) {
+				++j;
+			}
+			const bool found = (i - block < lanes && (matched >> (i - block)) & 1) || (j != _b_len && _b[j] == _a[i]);
+			if (!found) {
+				_dst[count++] = _a[i];
+			}
+		}
+		return count;
 	}
 
-	// * Binary string to number
-	template <class Ty = db::size_t, class char_type>
-	constexpr inline Ty bston(const char_type* const _str, const bool _big_endian = true)
+	// * compile time perfect hash map from a fixed set of string keys
+	// the constructor runs hash and displace: every key hashes once into a bucket,
+	// each bucket gets a displacement that moves all its keys into free slots
+	// lookup is one string hash, one slot probe and one db::memcmp
+	template <class char_type, class Value, db::size_t N>
+	class static_map
 	{
-		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
-		constexpr auto num_max = std::numeric_limits<Ty>::max();
-		const db::size_t _len = db::strlen(_str);
+		static_assert(N > 0, "static_map needs at least one key");
 
-		const bool is_negative = (_big_endian == true ? (*_str == '1') : *(_str + _len) == '1');
+	public:
+		using key_type = std::basic_string_view<char_type>;
 
-		Ty num = 0;
-		Ty tmp_num = 0;
+		struct entry
+		{
+			key_type key;
+			Value value;
+		};
 
-		for (db::size_t i = 0; i < _len; ++i)
+		constexpr explicit static_map(const std::pair<key_type, Value>(&_entries)[N])
+			: _seed(0), _disp{}, _slots{}
 		{
-			if (_str[i] != '0' && _str[i] != '1') {
-				throw std::invalid_argument("Only binary strings");
-			}
+			constexpr db::uint32_t max_disp = 1U << 12;
+
+			for (;; ++_seed) {
+				db::uint64_t hashes[N]{};
+				db::size_t bucket_size[N]{};
+				db::size_t order[N]{};
+				bool taken[N]{};
+				bool ok = true;
+
+				for (db::size_t i = 0; i != N; ++i) {
+					hashes[i] = hash(_entries[i].first, _seed);
+					++bucket_size[bucket(hashes[i])];
+					for (db::size_t j = 0; j != i; ++j) {
+						if (hashes[j] == hashes[i]) {
+							if (_entries[j].first == _entries[i].first) {
+								throw std::invalid_argument("static_map duplicate key");
+							}
+							ok = false;
+						}
+					}
+				}
+				if (!ok) {
+					continue;
+				}
 
-			if (_str[i] == '1') {
-				const db::size_t _expo = (_big_endian == true ? (_len - i - 1) : i);
-				if (_expo == 0) {
-					tmp_num += 1;
+				// Group key indices by bucket
+				db::size_t bucket_begin[N + 1]{};
+				db::size_t members[N]{};
+				for (db::size_t b = 0; b != N; ++b) {
+					bucket_begin[b + 1] = bucket_begin[b] + bucket_size[b];
 				}
-				else {
-					tmp_num += static_cast<db::size_t>(2) << (_expo - 1);
+				for (db::size_t i = 0, fill[N]{}; i != N; ++i) {
+					const db::size_t b = bucket(hashes[i]);
+					members[bucket_begin[b] + fill[b]++] = i;
 				}
-			}
-			else {
-				continue;
-			}
 
-			if (tmp_num < num) {
-				return num_max;
-			}
+				// Place the biggest buckets first while most slots are free
+				for (db::size_t i = 0; i != N; ++i) {
+					order[i] = i;
+				}
+				for (db::size_t i = 0; i != N; ++i) {
+					for (db::size_t j = i + 1; j != N; ++j) {
+						if (bucket_size[order[j]] > bucket_size[order[i]]) {
+							std::swap(order[i], order[j]);
+						}
+					}
+				}
 
-			num = tmp_num;
-		}
+				for (db::size_t b = 0; ok && b != N && bucket_size[order[b]] != 0; ++b) {
+					const db::size_t* first = members + bucket_begin[order[b]];
+					const db::size_t count = bucket_size[order[b]];
+					db::uint32_t disp = 1;
+
+					for (; disp != max_disp; ++disp) {
+						bool fits = true;
+						for (db::size_t i = 0; fits && i != count; ++i) {
+							const db::size_t slot_idx = slot(hashes[first[i]], disp);
+							fits = !taken[slot_idx];
+							for (db::size_t k = 0; fits && k != i; ++k) {
+								fits = slot(hashes[first[k]], disp) != slot_idx;
+							}
+						}
+						if (fits) {
+							break;
+						}
+					}
+
+					if (disp == max_disp) {
+						ok = false;
+						break;
+					}
+
+					_disp[order[b]] = disp;
+					for (db::size_t i = 0; i != count; ++i) {
+						const db::size_t slot_idx = slot(hashes[first[i]], disp);
+						taken[slot_idx] = true;
+						_slots[slot_idx] = entry{ _entries[first[i]].first, _entries[first[i]].second };
+					}
+				}
 
-		if (can_negative) {
-			if (is_negative) {
-				num *= static_cast<Ty>(-1);
+				if (ok) {
+					return;
+				}
+				for (db::size_t i = 0; i != N; ++i) {
+					_disp[i] = 0;
+				}
 			}
 		}
 
-		return num;
-	}
+		// * value of _key or nullptr
+		constexpr const Value* find(const key_type _key) const noexcept
+		{
+			DB_INSTRUMENT_SCOPE(static_map_find, _key.size());
 
-	// * Decimal string to number
-	template <class Ty = db::size_t, class char_type>
-	constexpr inline Ty dston(const char_type* _str)
-	{
-		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
-		constexpr auto num_max = std::numeric_limits<Ty>::max();
+			const db::uint64_t h = hash(_key, _seed);
+			const entry& candidate = _slots[slot(h, _disp[bucket(h)])];
 
-		const bool is_negative = (*_str == '-' ? ++_str : false);
+			if (candidate.key.size() == _key.size() && db::memcmp(candidate.key.data(), _key.data(), _key.size()) == 0) {
+				return &candidate.value;
+			}
+			return nullptr;
+		}
 
-		Ty num = 0;
-		Ty tmp_num = 0;
+		constexpr bool contains(const key_type _key) const noexcept { return find(_key) != nullptr; }
 
-		while (*_str)
+		constexpr const Value& at(const key_type _key) const
 		{
-			if (*_str < '0' || *_str > '9') {
-				throw std::invalid_argument("only number strings");
+			const Value* value = find(_key);
+			if (value == nullptr) {
+				throw std::out_of_range("static_map key not found");
 			}
+			return *value;
+		}
 
-			tmp_num = (num * 10) + (*_str++ - '0');
+		static constexpr db::size_t size() noexcept { return N; }
 
-			if (tmp_num < num) {
-				return num_max;
+		// * entries in slot order
+		constexpr const entry* begin() const noexcept { return _slots; }
+		constexpr const entry* end() const noexcept { return _slots + N; }
+
+	private:
+		db::uint64_t _seed;
+		db::uint32_t _disp[N];
+		entry _slots[N];
+
+		// murmur3 finalizer
+		static constexpr db::uint64_t mix(db::uint64_t _hash) noexcept
+		{
+			_hash ^= _hash >> 33;
+			_hash *= 0xFF51AFD7ED558CCDULL;
+			_hash ^= _hash >> 33;
+			_hash *= 0xC4CEB9FE1A85EC53ULL;
+			_hash ^= _hash >> 33;
+			return _hash;
+		}
+
+		// fnv-1a over whole chars, mixed so short keys still spread over the buckets
+		static constexpr db::uint64_t hash(const key_type _key, const db::uint64_t _seed) noexcept
+		{
+			db::uint64_t h = 0xCBF29CE484222325ULL ^ (_seed * 0x9E3779B97F4A7C15ULL);
+			for (const char_type ch : _key) {
+				h ^= static_cast<db::uint64_t>(static_cast<std::make_unsigned_t<char_type>>(ch));
+				h *= 0x100000001B3ULL;
 			}
+			return mix(h);
+		}
 
-			num = tmp_num;
+		static constexpr db::size_t bucket(const db::uint64_t _hash) noexcept
+		{
+			return static_cast<db::size_t>((_hash >> 32) % N);
 		}
 
-		if (is_negative) {
-			num *= static_cast<Ty>(-1);
+		// every displacement gives a new slot pattern
+		static constexpr db::size_t slot(const db::uint64_t _hash, const db::uint32_t _disp) noexcept
+		{
+			return static_cast<db::size_t>(mix(_hash ^ (_disp * 0x9E3779B97F4A7C15ULL)) % N);
 		}
+	};
 
-		return num;
+	// * db::make_static_map<char, my_enum>({ { "get", my_enum::get }, { "put", my_enum::put } })
+	template <class char_type, class Value, db::size_t N>
+	constexpr inline db::static_map<char_type, Value, N> make_static_map(const std::pair<std::basic_string_view<char_type>, Value>(&_entries)[N])
+	{
+		return db::static_map<char_type, Value, N>(_entries);
 	}
 
-	// * Hex string to number
-	template <class Ty = db::size_t, class char_type>
-	constexpr inline Ty hston(const char_type* _str)
+	// * learned index over a sorted array of numbers, pgm style
+	// the keys are cut into linear segments that predict every position within _epsilon,
+	// the segments are indexed again the same way until one segment is left
+	// a lookup walks the levels and finishes with db::binary_search over 2 * _epsilon + 2 numbers
+	// only a pointer to the data is kept, it has to outlive the index
+	template <class Ty>
+	class pgm_index
 	{
-		constexpr auto can_negative = !std::is_unsigned_v<Ty>;
-		constexpr auto num_max = std::numeric_limits<Ty>::max();
-
-		const bool is_negative = (*_str == '-' ? ++_str : false);
-
-		if (*_str == 'x' || *_str == 'X') {
-			_str += 2;
-		}
+		static_assert(std::is_arithmetic_v<Ty>, "pgm_index needs a number type");
 
-		Ty num = 0;
-		Ty tmp_num = 0;
+	public:
+		// error bound of the levels above the data
+		static constexpr db::size_t level_epsilon = 4;
 
-		while (*_str)
+		pgm_index(const Ty* _sorted, const db::size_t _count, const db::size_t _max_error = 64)
+			: _data(_sorted), _len(_count), _epsilon(_max_error)
 		{
-			tmp_num = num * 16;
-
-			if (*_str >= '0' && *_str <= '9') {
-				tmp_num += *_str++ - '0';
+			if (_len == 0) {
+				return;
 			}
-			else if (*_str >= 'a' && *_str <= 'f') {
-				tmp_num += 10 + *_str++ - 'a';
+
+			// only the first of equal keys goes into the model so lower bounds stay exact
+			std::vector<Ty> keys;
+			std::vector<db::size_t> positions;
+			for (db::size_t i = 0; i != _len; ++i) {
+				if (i == 0 || _data[i - 1] < _data[i]) {
+					keys.push_back(_data[i]);
+					positions.push_back(i);
+				}
 			}
-			else if (*_str >= 'A' && *_str <= 'F') {
-				tmp_num += 10 + *_str++ - 'A';
+
+			_levels.push_back(build(keys.data(), positions.data(), keys.size(), _epsilon));
+			while (_levels.back().size() > 1) {
+				const std::vector<segment>& below = _levels.back();
+				if (_levels.size() > 1 && below.size() == _levels[_levels.size() - 2].size()) {
+					throw std::runtime_error("pgm_index level did not shrink");
+				}
+				keys.resize(below.size());
+				positions.resize(below.size());
+				for (db::size_t i = 0; i != below.size(); ++i) {
+					keys[i] = below[i].key;
+					positions[i] = i;
+				}
+				_levels.push_back(build(keys.data(), positions.data(), keys.size(), level_epsilon));
 			}
-			else {
-				throw std::invalid_argument("only hex number strings");
+		}
+
+		// * first number not less than _key, or end()
+		const Ty* lower_bound(const Ty& _key) const
+		{
+			DB_INSTRUMENT_SCOPE(pgm_index_lower_bound, _len);
+
+			if (_len == 0) {
+				return _data;
 			}
 
-			if (tmp_num < num) {
-				return num_max;
+			// last segment whose key is not above _key, level by level
+			db::size_t seg = 0;
+			for (db::size_t level = _levels.size() - 1; level-- > 0;) {
+				const std::vector<segment>& segs = _levels[level];
+				const segment* found = window_search(segs.data(), segs.size(), _levels[level + 1][seg].predict(_key, segs.size()), level_epsilon, _key,
+					[](const segment& _seg, const Ty& _what) { return !(_what < _seg.key); });
+				seg = found == segs.data() ? 0 : static_cast<db::size_t>(found - segs.data()) - 1;
 			}
 
-			num = tmp_num;
+			return window_search(_data, _len, _levels[0][seg].predict(_key, _len), _epsilon, _key, std::less<>{});
 		}
 
-		if constexpr (can_negative) {
-			if (is_negative) {
-				num *= static_cast<Ty>(-1);
-			}
+		bool contains(const Ty& _key) const
+		{
+			const Ty* found = lower_bound(_key);
+			return found != end() && !(_key < *found);
 		}
 
-		return num;
-	}
+		const Ty* begin() const noexcept { return _data; }
+		const Ty* end() const noexcept { return _data + _len; }
+		db::size_t size() const noexcept { return _len; }
 
-	// * Number string to number
-	// Binary
-	// Decimal
-	// Hexadecimal
-	// - not 100% accurate
-	template <class Ty = db::size_t, class char_type>
-	constexpr inline Ty ston(const char_type* _str, const bool _big_endian_if_bin = true)
-	{
-		switch(db::guess_base<char_type>(_str))
+		db::size_t epsilon() const noexcept { return _epsilon; }
+		db::size_t levels() const noexcept { return _levels.size(); }
+		db::size_t segments() const noexcept { return _levels.empty() ? 0 : _levels[0].size(); }
+
+	private:
+		struct segment
 		{
-		case 2:
-			return db::bston<Ty, char_type>(_str, _big_endian_if_bin);
-		case 10:
-			return db::dston<Ty, char_type>(_str);
-		case 16:
-			return db::hston<Ty, char_type>(_str);
-		default:
-			return 0;
-		}
-	}
-}
+			Ty key;
+			double slope;
+			db::size_t pos;
 
-// SEARCH
-namespace db
-{
-	// * Binary search
-	template<class fIter, class Ty, class Fn>
-	constexpr inline fIter binary_search(fIter _first, fIter _last, const Ty& _what, Fn&& _cmp_func)
-	{
-		fIter iter;
-		std::ptrdiff_t count = std::distance(_first, _last);
-		db::size_t step;
+			db::size_t predict(const Ty& _key, const db::size_t _len) const noexcept
+			{
+				if (!(key < _key)) {
+					return std::min(pos, _len - 1);
+				}
+				const double pred = static_cast<double>(pos) + slope * distance(key, _key);
+				return pred >= static_cast<double>(_len - 1) ? _len - 1 : static_cast<db::size_t>(pred);
+			}
+		};
 
-		while (count > 0LL) {
-			step = count / 2ULL;
-			iter = _first;
-			std::advance(iter, step);
+		const Ty* _data;
+		db::size_t _len;
+		db::size_t _epsilon;
+		std::vector<std::vector<segment>> _levels; // data segments first, one root segment last
 
-			if (_cmp_func(*iter, _what)) {
-				_first = ++iter;
-				count -= step + 1ULL;
+		// _to - _from for _from <= _to without signed overflow, integers are subtracted as radix keys
+		static double distance(const Ty& _from, const Ty& _to) noexcept
+		{
+			if constexpr (std::is_integral_v<Ty>) {
+				return static_cast<double>(db::radix_key(_to) - db::radix_key(_from));
 			}
 			else {
-				count = step;
+				return static_cast<double>(_to) - static_cast<double>(_from);
 			}
 		}
 
-		return _first;
-	}
+		// greedy shrinking cone, grows a segment while one slope keeps every point within _epsilon
+		static std::vector<segment> build(const Ty* _keys, const db::size_t* _positions, const db::size_t _len, const db::size_t _epsilon)
+		{
+			std::vector<segment> segs;
+			const double eps = static_cast<double>(_epsilon);
+
+			for (db::size_t i = 0; i != _len;) {
+				const Ty key = _keys[i];
+				const db::size_t pos = _positions[i];
+				double slope_min = 0.0;
+				double slope_max = std::numeric_limits<double>::infinity();
+
+				db::size_t j = i + 1;
+				for (; j != _len; ++j) {
+					const double dx = distance(key, _keys[j]);
+					const double dy = static_cast<double>(_positions[j] - pos);
+					const double lo = std::max(slope_min, (dy - eps) / dx);
+					const double hi = std::min(slope_max, (dy + eps) / dx);
+					if (lo > hi) {
+						break;
+					}
+					slope_min = lo;
+					slope_max = hi;
+				}
 
-	// * Binary search
-	template<class fIter, class Ty, class Fn>
-	constexpr inline fIter binary_search(fIter _first, fIter _last, Ty&& _what, Fn&& _cmp_func)
-	{
-		db::binary_search<fIter, Ty>(_first, _last, _what, std::move(_cmp_func));
-	}
+				const double slope = j == i + 1 ? 0.0 : slope_max == std::numeric_limits<double>::infinity() ? slope_min : (slope_min + slope_max) / 2;
+				segs.push_back(segment{ key, slope, pos });
+				i = j;
+			}
+			return segs;
+		}
 
-#ifdef _XSTDDEF_
-	// * Binary search ( std::less )
-	template<class fIter, class Ty>
-	constexpr inline fIter binary_search(fIter _first, fIter _last, const Ty& _what)
-	{
-		return db::binary_search<fIter, Ty>(_first, _last, _what, std::move(std::less<>{}));
-	}
+		// db::binary_search around _pred, widened to the whole range if the answer is outside the window
+		template <class Elem, class Fn>
+		static const Elem* window_search(const Elem* _first, const db::size_t _len, const db::size_t _pred, const db::size_t _epsilon, const Ty& _key, Fn _cmp)
+		{
+			const db::size_t lo = _pred > _epsilon ? _pred - _epsilon : 0;
+			const db::size_t hi = std::min(_len, _pred + _epsilon + 2);
 
-	// * Binary search ( std::less )
-	template<class fIter, class Ty>
-	constexpr inline fIter binary_search(fIter _first, fIter _last, Ty&& _what)
-	{
-		return db::binary_search<fIter, Ty>(_first, _last, _what, std::move(std::less<>{}));
-	}
-#endif
+			const Elem* found = db::binary_search(_first + lo, _first + hi, _key, _cmp);
+			if (found == _first + hi && hi != _len) {
+				return db::binary_search(_first + hi, _first + _len, _key, _cmp);
+			}
+			if (found == _first + lo && lo != 0 && !_cmp(_first[lo - 1], _key)) {
+				return db::binary_search(_first, _first + lo, _key, _cmp);
+			}
+			return found;
+		}
+	};
 }
 
 // OUTPUT